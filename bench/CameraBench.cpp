@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include "Camera.hpp"
+#include "Frustum.hpp"
+#include "Projection.hpp"
+
+static void BM_CameraViewMatrix(benchmark::State& state)
+{
+  Camera camera = CameraBuilder().setPosition(0.0F, 0.0F, 3.0F).build();
+  for (auto _ : state)
+  {
+    auto view = camera.getViewMatrix();
+    benchmark::DoNotOptimize(view);
+  }
+}
+BENCHMARK(BM_CameraViewMatrix);
+
+static void BM_CameraViewMatrixAfterMove(benchmark::State& state)
+{
+  Camera camera = CameraBuilder().setPosition(0.0F, 0.0F, 3.0F).build();
+  for (auto _ : state)
+  {
+    camera.updatePosition(Camera::MoveDir::FORWARD, 1e-3F);
+    auto view = camera.getViewMatrix();
+    benchmark::DoNotOptimize(view);
+  }
+}
+BENCHMARK(BM_CameraViewMatrixAfterMove);
+
+static void BM_CameraFrustum(benchmark::State& state)
+{
+  Camera camera = CameraBuilder().setPosition(0.0F, 0.0F, 3.0F).build();
+  Projection projection =
+      ProjectionBuilder().withAspectRatio(16.0F / 9.0F).build();
+  for (auto _ : state)
+  {
+    const Frustum& frustum = camera.getFrustum(projection);
+    benchmark::DoNotOptimize(frustum.getPlanes());
+  }
+}
+BENCHMARK(BM_CameraFrustum);
+
+static void BM_CameraUpdateDirection(benchmark::State& state)
+{
+  Camera camera = CameraBuilder().build();
+  for (auto _ : state)
+  {
+    camera.updateDirection(0.5F, 0.25F);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CameraUpdateDirection);
+
+static void BM_ProjectionMatrix(benchmark::State& state)
+{
+  Projection projection =
+      ProjectionBuilder().withAspectRatio(16.0F / 9.0F).build();
+  for (auto _ : state)
+  {
+    auto proj = projection.getProjectionMatrix();
+    benchmark::DoNotOptimize(proj);
+  }
+}
+BENCHMARK(BM_ProjectionMatrix);
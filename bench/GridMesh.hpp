@@ -0,0 +1,50 @@
+#ifndef BENCH_GRIDMESH_HPP_
+#define BENCH_GRIDMESH_HPP_
+
+#include <assimp/mesh.h>
+
+inline aiMesh* makeGridMesh(unsigned int side)
+{
+  auto* mesh = new aiMesh();
+
+  mesh->mNumVertices = side * side;
+  mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+  mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+  mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+  for (unsigned int y = 0; y < side; y++)
+  {
+    for (unsigned int x = 0; x < side; x++)
+    {
+      unsigned int i = y * side + x;
+      mesh->mVertices[i] = aiVector3D(x, 0.0F, y);
+      mesh->mNormals[i] = aiVector3D(0.0F, 1.0F, 0.0F);
+      mesh->mTextureCoords[0][i] = aiVector3D(
+          static_cast<float>(x) / side, static_cast<float>(y) / side, 0.0F);
+    }
+  }
+
+  mesh->mNumFaces = (side - 1) * (side - 1) * 2;
+  mesh->mFaces = new aiFace[mesh->mNumFaces];
+  unsigned int face = 0;
+  for (unsigned int y = 0; y + 1 < side; y++)
+  {
+    for (unsigned int x = 0; x + 1 < side; x++)
+    {
+      unsigned int i = y * side + x;
+      unsigned int quad[2][3] = { { i, i + side, i + 1 },
+                                  { i + 1, i + side, i + side + 1 } };
+      for (auto& triangle : quad)
+      {
+        mesh->mFaces[face].mNumIndices = 3;
+        mesh->mFaces[face].mIndices = new unsigned int[3];
+        for (int k = 0; k < 3; k++)
+          mesh->mFaces[face].mIndices[k] = triangle[k];
+        face++;
+      }
+    }
+  }
+
+  return mesh;
+}
+
+#endif  // BENCH_GRIDMESH_HPP_
@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "Image.hpp"
+
+// A 512x512 RGBA gradient with low-amplitude noise, compressed by libpng, so
+// decoding runs inflate over real matches and literals.
+static const std::string DECODE_FIXTURE =
+    std::string(BENCH_DATA_DIR) + "/gradient.png";
+
+static void BM_ImageDecode(benchmark::State& state)
+{
+  std::size_t bytes = 0;
+  for (auto _ : state)
+  {
+    Image image(DECODE_FIXTURE);
+    benchmark::DoNotOptimize(image.data());
+    bytes = image.size();
+  }
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<std::int64_t>(bytes));
+}
+BENCHMARK(BM_ImageDecode)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,67 @@
+#include <assimp/mesh.h>
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "GridMesh.hpp"
+#include "JobSystem.hpp"
+#include "Model.hpp"
+
+static constexpr unsigned int MESH_COUNT = 64;
+static constexpr unsigned int MESH_SIDE = 128;
+
+static void BM_ParallelConvert(benchmark::State& state)
+{
+  unsigned int cores = static_cast<unsigned int>(state.range(0));
+  JobSystem jobs(cores - 1);
+
+  std::vector<aiMesh*> meshes;
+  for (unsigned int i = 0; i < MESH_COUNT; i++)
+    meshes.push_back(makeGridMesh(MESH_SIDE));
+
+  std::vector<std::vector<Vertex>> vertices(MESH_COUNT);
+  std::vector<std::vector<unsigned int>> indices(MESH_COUNT);
+  for (auto _ : state)
+  {
+    jobs.parallelFor(
+        MESH_COUNT,
+        1,
+        [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; i++)
+          {
+            vertices[i] = Model::convertVertices(meshes[i]);
+            indices[i] = Model::convertIndices(meshes[i]);
+          }
+        });
+    benchmark::DoNotOptimize(vertices.data());
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * MESH_COUNT);
+
+  for (aiMesh* mesh : meshes)
+    delete mesh;
+}
+BENCHMARK(BM_ParallelConvert)
+    ->DenseRange(1, static_cast<int>(std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_JobOverhead(benchmark::State& state)
+{
+  JobSystem jobs;
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    jobs.parallelFor(
+        count,
+        1,
+        [](std::size_t begin, std::size_t end)
+        { benchmark::DoNotOptimize(begin + end); });
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_JobOverhead)->Arg(64)->Arg(1024)->UseRealTime();
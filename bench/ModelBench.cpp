@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include "GridMesh.hpp"
+#include "Model.hpp"
+
+static void BM_ConvertVertices(benchmark::State& state)
+{
+  aiMesh* mesh = makeGridMesh(static_cast<unsigned int>(state.range(0)));
+  for (auto _ : state)
+  {
+    auto vertices = Model::convertVertices(mesh);
+    benchmark::DoNotOptimize(vertices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->mNumVertices);
+  delete mesh;
+}
+BENCHMARK(BM_ConvertVertices)->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_ConvertIndices(benchmark::State& state)
+{
+  aiMesh* mesh = makeGridMesh(static_cast<unsigned int>(state.range(0)));
+  for (auto _ : state)
+  {
+    auto indices = Model::convertIndices(mesh);
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->mNumFaces);
+  delete mesh;
+}
+BENCHMARK(BM_ConvertIndices)->Arg(64)->Arg(256)->Arg(1024);
@@ -0,0 +1,72 @@
+#include <assimp/mesh.h>
+#include <benchmark/benchmark.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <thread>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "GridMesh.hpp"
+#include "JobSystem.hpp"
+#include "Model.hpp"
+#include "OcclusionBuffer.hpp"
+
+static constexpr unsigned int OCCLUDER_SIDE = 64;
+
+static glm::mat4 occluderViewProjection()
+{
+  glm::mat4 projection =
+      glm::perspective(glm::radians(45.0F), 2.0F, 0.1F, 100.0F);
+  glm::mat4 view = glm::lookAt(
+      glm::vec3(32.0F, 40.0F, 32.0F),
+      glm::vec3(32.0F, 0.0F, 31.0F),
+      glm::vec3(0.0F, 1.0F, 0.0F));
+  return projection * view;
+}
+
+static void BM_RasterizeOccluders(benchmark::State& state)
+{
+  unsigned int cores = static_cast<unsigned int>(state.range(0));
+  JobSystem jobs(cores - 1);
+  OcclusionBuffer buffer(
+      OcclusionBuffer::DEFAULT_WIDTH, OcclusionBuffer::DEFAULT_HEIGHT, &jobs);
+
+  aiMesh* mesh = makeGridMesh(OCCLUDER_SIDE);
+  std::vector<Vertex> vertices = Model::convertVertices(mesh);
+  std::vector<unsigned int> indices = Model::convertIndices(mesh);
+  delete mesh;
+
+  glm::mat4 viewProjection = occluderViewProjection();
+  for (auto _ : state)
+  {
+    buffer.clear();
+    buffer.addOccluder(vertices, indices, indices.size(), viewProjection);
+    buffer.finish();
+    benchmark::DoNotOptimize(buffer.getDepth(0, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * indices.size() / 3);
+}
+BENCHMARK(BM_RasterizeOccluders)
+    ->DenseRange(1, static_cast<int>(std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_OcclusionTest(benchmark::State& state)
+{
+  OcclusionBuffer buffer;
+
+  aiMesh* mesh = makeGridMesh(OCCLUDER_SIDE);
+  std::vector<Vertex> vertices = Model::convertVertices(mesh);
+  std::vector<unsigned int> indices = Model::convertIndices(mesh);
+  delete mesh;
+
+  glm::mat4 viewProjection = occluderViewProjection();
+  buffer.addOccluder(vertices, indices, indices.size(), viewProjection);
+  buffer.finish();
+
+  BoundingSphere hidden = { glm::vec3(32.0F, -4.0F, 32.0F), 2.0F };
+  for (auto _ : state)
+    benchmark::DoNotOptimize(buffer.isVisible(hidden, viewProjection));
+}
+BENCHMARK(BM_OcclusionTest);
@@ -0,0 +1,108 @@
+# Runs the profile-guided optimization pipeline:
+#   cmake -DSOURCE_DIR=<repo> -P cmake/PgoPipeline.cmake
+#
+# Builds an instrumented headless runner, trains it on a deterministic
+# workload, rebuilds with the collected profile and compares the result
+# against a plain Release build running the same workload.
+
+if(NOT SOURCE_DIR)
+    set(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/..")
+endif()
+get_filename_component(SOURCE_DIR "${SOURCE_DIR}" ABSOLUTE)
+if(NOT PGO_FRAMES)
+    set(PGO_FRAMES 300)
+endif()
+if(NOT PGO_MODEL)
+    set(PGO_MODEL "./assets/models/backpack/backpack.obj")
+endif()
+
+set(PGO_BUILD_DIR "${SOURCE_DIR}/build-pgo")
+set(PLAIN_BUILD_DIR "${SOURCE_DIR}/build-plain")
+set(PGO_PROFILE_DIR "${PGO_BUILD_DIR}/profile")
+
+set(WORKLOAD_ARGS --frames ${PGO_FRAMES} --warmup 0 --model ${PGO_MODEL})
+
+function(run_step)
+    execute_process(
+        COMMAND ${ARGN}
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO step failed: ${ARGN}")
+    endif()
+endfunction()
+
+function(configure_and_build buildDir)
+    run_step(
+        ${CMAKE_COMMAND} -S "${SOURCE_DIR}" -B "${buildDir}"
+        -DCMAKE_BUILD_TYPE=Release -DBUILD_HEADLESS=ON ${ARGN}
+    )
+    run_step(${CMAKE_COMMAND} --build "${buildDir}" --target GLFWTemplate_headless)
+endfunction()
+
+function(run_workload buildDir outVar)
+    execute_process(
+        COMMAND "${buildDir}/headless" ${WORKLOAD_ARGS}
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Workload failed in ${buildDir}")
+    endif()
+    set(${outVar} "${output}" PARENT_SCOPE)
+endfunction()
+
+function(read_metric output name outVar outMicrosVar)
+    string(REGEX MATCH "${name} ([0-9]+)\\.([0-9][0-9][0-9])" match "${output}")
+    set(${outVar} "${CMAKE_MATCH_1}.${CMAKE_MATCH_2}" PARENT_SCOPE)
+
+    string(REGEX REPLACE "^0+([0-9])" "\\1" micros
+        "${CMAKE_MATCH_1}${CMAKE_MATCH_2}")
+    set(${outMicrosVar} "${micros}" PARENT_SCOPE)
+endfunction()
+
+# -- Instrumented build and training run
+
+file(REMOVE_RECURSE "${PGO_PROFILE_DIR}")
+configure_and_build(
+    "${PGO_BUILD_DIR}"
+    -DPGO_MODE=GENERATE -DPGO_PROFILE_DIR=${PGO_PROFILE_DIR}
+)
+run_workload("${PGO_BUILD_DIR}" trainingOutput)
+
+file(GLOB rawProfiles "${PGO_PROFILE_DIR}/*.profraw")
+if(rawProfiles)
+    find_program(LLVM_PROFDATA llvm-profdata REQUIRED)
+    run_step(
+        ${LLVM_PROFDATA} merge -output=${PGO_PROFILE_DIR}/default.profdata
+        ${rawProfiles}
+    )
+endif()
+
+# -- Optimized and plain builds
+
+configure_and_build(
+    "${PGO_BUILD_DIR}"
+    -DPGO_MODE=USE -DPGO_PROFILE_DIR=${PGO_PROFILE_DIR}
+)
+configure_and_build("${PLAIN_BUILD_DIR}" -DPGO_MODE=OFF)
+
+# -- Report
+
+run_workload("${PLAIN_BUILD_DIR}" plainOutput)
+run_workload("${PGO_BUILD_DIR}" pgoOutput)
+
+message("metric\tplain\tpgo\tdelta")
+foreach(metric startup_ms mean_ms p50_ms p99_ms max_ms)
+    read_metric("${plainOutput}" ${metric} plain plainMicros)
+    read_metric("${pgoOutput}" ${metric} pgo pgoMicros)
+
+    set(delta "n/a")
+    if(plainMicros GREATER 0)
+        math(EXPR delta "(${pgoMicros} - ${plainMicros}) * 100 / ${plainMicros}")
+        set(delta "${delta}%")
+    endif()
+    message("${metric}\t${plain}\t${pgo}\t${delta}")
+endforeach()
@@ -0,0 +1,34 @@
+#ifndef INCLUDE_INCLUDE_APPLICATION_HPP_
+#define INCLUDE_INCLUDE_APPLICATION_HPP_
+
+#include "FramePacer.hpp"
+#include "FrameStats.hpp"
+
+class Application
+{
+ protected:
+  static constexpr double DEFAULT_FIXED_TIMESTEP = 1.0 / 60.0;
+  static constexpr double MAX_FRAME_TIME = 0.25;
+  static constexpr unsigned int MAX_STEPS_PER_FRAME = 8;
+
+  FrameStats frameStats;
+  FramePacer framePacer;
+  double fixedTimestep = DEFAULT_FIXED_TIMESTEP;
+
+ public:
+  virtual ~Application() = default;
+
+  void run();
+
+  const FrameStats& getFrameStats() const noexcept;
+
+ protected:
+  virtual bool isRunning() = 0;
+  virtual void update(double deltaTime) = 0;
+  virtual void fixedUpdate(double timestep);
+  virtual void render(double alpha) = 0;
+  virtual void present() = 0;
+  virtual void endFrame();
+};
+
+#endif  // INCLUDE_INCLUDE_APPLICATION_HPP_
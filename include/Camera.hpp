@@ -1,8 +1,19 @@
 #ifndef INCLUDE_INCLUDE_CAMERA_HPP_
 #define INCLUDE_INCLUDE_CAMERA_HPP_
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
+#include "Frustum.hpp"
+#include "Projection.hpp"
+
+struct CameraState
+{
+  glm::vec3 position;
+  float yaw;
+  float pitch;
+};
+
 class Camera
 {
  private:
@@ -19,6 +30,18 @@ class Camera
   float speed;
   float sensitivity;
 
+  std::uint64_t generation;
+
+  mutable std::uint64_t viewGeneration = 0;
+  mutable glm::mat4 view;
+  mutable glm::mat4 inverseView;
+
+  mutable std::uint64_t viewProjectionGeneration = 0;
+  mutable std::uint64_t projectionGeneration = 0;
+  mutable glm::mat4 viewProjection;
+  mutable glm::mat4 inverseViewProjection;
+  mutable Frustum frustum;
+
   Camera(
       glm::vec3 position,
       glm::vec3 worldUp,
@@ -39,10 +62,28 @@ class Camera
     RIGHT
   };
 
-  glm::mat4 getViewMatrix() const;
+  const glm::mat4& getViewMatrix() const;
+  const glm::mat4& getInverseViewMatrix() const;
+  const glm::mat4& getViewProjectionMatrix(const Projection& projection) const;
+  const glm::mat4& getInverseViewProjectionMatrix(
+      const Projection& projection) const;
+  const Frustum& getFrustum(const Projection& projection) const;
+  std::uint64_t getGeneration() const noexcept;
+
   void updatePosition(MoveDir direction, float deltaTime) noexcept;
   void updateDirection(float xoffset, float yoffset);
 
+  void setPosition(glm::vec3 position) noexcept;
+  void setOrientation(float yaw, float pitch);
+
+  CameraState getState() const noexcept;
+  void setState(const CameraState& state);
+
+  static CameraState interpolate(
+      const CameraState& from,
+      const CameraState& to,
+      float alpha) noexcept;
+
   glm::vec3 getPosition() const noexcept;
   glm::vec3 getFront() const noexcept;
   glm::vec3 getUp() const noexcept;
@@ -51,6 +92,9 @@ class Camera
 
  private:
   void _updateDirection();
+  void _markChanged() noexcept;
+  void _updateView() const;
+  void _updateViewProjection(const Projection& projection) const;
 };
 
 class CameraBuilder
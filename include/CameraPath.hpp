@@ -0,0 +1,28 @@
+#ifndef INCLUDE_INCLUDE_CAMERAPATH_HPP_
+#define INCLUDE_INCLUDE_CAMERAPATH_HPP_
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Camera.hpp"
+
+using CameraKeyframe = CameraState;
+
+class CameraPath
+{
+ private:
+  std::vector<CameraKeyframe> keyframes;
+
+ public:
+  CameraPath(std::vector<CameraKeyframe>&& keyframes);
+
+  void apply(Camera& camera, float t) const;
+
+  static CameraPath orbit(
+      glm::vec3 center,
+      float radius,
+      float height,
+      int steps);
+};
+
+#endif  // INCLUDE_INCLUDE_CAMERAPATH_HPP_
@@ -0,0 +1,55 @@
+#ifndef INCLUDE_INCLUDE_CASCADEDSHADOWMAP_HPP_
+#define INCLUDE_INCLUDE_CASCADEDSHADOWMAP_HPP_
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+#include "Frustum.hpp"
+
+struct ShadowCascade
+{
+  glm::mat4 viewProjection;
+  glm::mat4 shadowMatrix;
+  float splitFar;
+  int x, y;
+};
+
+class CascadedShadowMap
+{
+ public:
+  static constexpr int ATLAS_TILES = 2;
+  static constexpr std::size_t CASCADE_COUNT = ATLAS_TILES * ATLAS_TILES;
+  static constexpr int DEFAULT_TILE_SIZE = 1024;
+  static constexpr float SPLIT_LAMBDA = 0.75F;
+  static constexpr float CASTER_DISTANCE = 50.0F;
+
+ private:
+  unsigned int fbo, depthTexture;
+  int tileSize;
+
+  std::array<ShadowCascade, CASCADE_COUNT> cascades;
+
+ public:
+  explicit CascadedShadowMap(int tileSize = DEFAULT_TILE_SIZE);
+  ~CascadedShadowMap() noexcept;
+
+  CascadedShadowMap(const CascadedShadowMap& other) = delete;
+  CascadedShadowMap& operator=(const CascadedShadowMap& other) = delete;
+
+  void update(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      glm::vec3 lightDirection);
+
+  void begin() const noexcept;
+  void beginCascade(std::size_t cascade) const noexcept;
+  void end() const noexcept;
+
+  const ShadowCascade& getCascade(std::size_t cascade) const noexcept;
+  Frustum getCascadeFrustum(std::size_t cascade) const;
+  unsigned int getTexture() const noexcept;
+  int getTileSize() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_CASCADEDSHADOWMAP_HPP_
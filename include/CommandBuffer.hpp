@@ -0,0 +1,94 @@
+#ifndef INCLUDE_INCLUDE_COMMANDBUFFER_HPP_
+#define INCLUDE_INCLUDE_COMMANDBUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct IndexRanges
+{
+  std::vector<int> counts;
+  std::vector<const void*> offsets;
+};
+
+struct DrawIndirectCommand
+{
+  unsigned int count;
+  unsigned int instanceCount;
+  unsigned int firstIndex;
+  unsigned int baseVertex;
+  unsigned int baseInstance;
+};
+
+class CommandBuffer
+{
+ private:
+  static constexpr unsigned int MAX_UNITS = 16;
+
+  enum class Op : std::uint8_t
+  {
+    USE_PROGRAM,
+    BIND_VERTEX_ARRAY,
+    BIND_TEXTURE,
+    BIND_UNIFORM_RANGE,
+    UNIFORM_INT,
+    UNIFORM_FLOAT,
+    UNIFORM_MAT4,
+    DRAW_ELEMENTS,
+    MULTI_DRAW_ELEMENTS,
+    MULTI_DRAW_ELEMENTS_INDIRECT
+  };
+
+  std::vector<std::byte> bytes;
+  std::size_t commandCount = 0;
+
+  unsigned int currentProgram = 0;
+  unsigned int currentVertexArray = 0;
+  std::array<unsigned int, MAX_UNITS> currentTextures {};
+
+ public:
+  void clear() noexcept;
+
+  bool empty() const noexcept;
+  std::size_t size() const noexcept;
+  std::size_t getCommandCount() const noexcept;
+
+  void useProgram(unsigned int program);
+  void bindVertexArray(unsigned int vao, unsigned int positionVao = 0);
+  void bindTexture(unsigned int unit, unsigned int target, unsigned int id);
+  void bindUniformRange(
+      unsigned int binding,
+      unsigned int buffer,
+      std::size_t offset,
+      std::size_t size);
+  void setUniform(int location, int value);
+  void setUniform(int location, float value);
+  void setUniform(int location, const glm::mat4& value);
+  void drawElements(unsigned int count, std::size_t firstIndex);
+  void multiDrawElements(std::size_t rangeSlot);
+  void multiDrawElementsIndirect(std::size_t firstCommand, unsigned int count);
+
+  void append(const CommandBuffer& other);
+
+  void execute(
+      std::size_t uniformBase = 0,
+      const std::vector<IndexRanges>* ranges = nullptr) const;
+  void executeGeometry(
+      std::size_t uniformBase = 0,
+      const std::vector<IndexRanges>* ranges = nullptr) const;
+
+ private:
+  void replay(
+      std::size_t uniformBase,
+      const std::vector<IndexRanges>* ranges,
+      bool geometryOnly) const;
+
+  template <typename T>
+  void write(const T& value);
+  template <typename T>
+  T read(std::size_t& offset) const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_COMMANDBUFFER_HPP_
@@ -0,0 +1,42 @@
+#ifndef INCLUDE_INCLUDE_DEPTHPYRAMID_HPP_
+#define INCLUDE_INCLUDE_DEPTHPYRAMID_HPP_
+
+#include <string>
+#include <vector>
+
+#include "Shader.hpp"
+
+class DepthPyramid
+{
+ private:
+  Shader downsampleShader;
+  unsigned int vao;
+  unsigned int depthTexture, depthFbo;
+  unsigned int pyramidTexture;
+  std::vector<unsigned int> levelFbos;
+  int width, height;
+  bool reverseZ;
+
+ public:
+  DepthPyramid(
+      const std::string& shaderDirectory,
+      int width,
+      int height,
+      bool reverseZ = false);
+  ~DepthPyramid() noexcept;
+
+  DepthPyramid(const DepthPyramid& other) = delete;
+  DepthPyramid& operator=(const DepthPyramid& other) = delete;
+
+  void resize(int width, int height);
+  void build(unsigned int sourceFramebuffer);
+
+  unsigned int getTexture() const noexcept;
+  int getLevelCount() const noexcept;
+
+ private:
+  void create();
+  void destroy() noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_DEPTHPYRAMID_HPP_
@@ -0,0 +1,22 @@
+#ifndef INCLUDE_INCLUDE_EGLCONTEXT_HPP_
+#define INCLUDE_INCLUDE_EGLCONTEXT_HPP_
+
+class EglContext
+{
+ private:
+  void* display;
+  void* context;
+
+ public:
+  EglContext(int major, int minor);
+  ~EglContext() noexcept;
+
+  EglContext(const EglContext& other) = delete;
+  EglContext& operator=(const EglContext& other) = delete;
+
+  void makeCurrent() const;
+
+  static void* getProcAddress(const char* name);
+};
+
+#endif  // INCLUDE_INCLUDE_EGLCONTEXT_HPP_
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_INCLUDE_FRAMEPACER_HPP_
+#define INCLUDE_INCLUDE_FRAMEPACER_HPP_
+
+#include <chrono>
+
+enum class SwapMode
+{
+  IMMEDIATE,
+  VSYNC,
+  ADAPTIVE
+};
+
+class FramePacer
+{
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::microseconds SPIN_THRESHOLD =
+      std::chrono::microseconds(1500);
+
+  Clock::duration interval = Clock::duration::zero();
+  Clock::time_point deadline;
+  bool pacing = false;
+
+ public:
+  explicit FramePacer(double targetFps = 0.0) noexcept;
+
+  void setTargetFps(double targetFps) noexcept;
+  double getTargetFps() const noexcept;
+  bool isEnabled() const noexcept;
+
+  void wait();
+
+  static int swapInterval(SwapMode mode) noexcept;
+  static const char* swapModeStr(SwapMode mode) noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_FRAMEPACER_HPP_
@@ -0,0 +1,55 @@
+#ifndef INCLUDE_INCLUDE_FRAMESNAPSHOTBUFFER_HPP_
+#define INCLUDE_INCLUDE_FRAMESNAPSHOTBUFFER_HPP_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <vector>
+
+#include "Renderer.hpp"
+
+struct FrameSnapshot
+{
+  std::uint64_t frame = 0;
+
+  glm::mat4 view = glm::mat4(1.0F);
+  glm::mat4 projection = glm::mat4(1.0F);
+  std::uint64_t viewGeneration = 0;
+  std::uint64_t projectionGeneration = 0;
+  std::vector<RenderInstance> instances;
+
+  int viewportWidth = 0;
+  int viewportHeight = 0;
+  int swapInterval = 1;
+
+  bool hasInput = false;
+  std::chrono::steady_clock::time_point inputTime;
+};
+
+class FrameSnapshotBuffer
+{
+ private:
+  std::array<FrameSnapshot, 2> snapshots;
+  unsigned int writeIndex = 0;
+  unsigned int readIndex = 1;
+
+  bool pending = false;
+  bool closed = false;
+
+  std::mutex mutex;
+  std::condition_variable published;
+  std::condition_variable consumed;
+
+ public:
+  FrameSnapshot* beginWrite();
+  void publish();
+
+  const FrameSnapshot* acquire();
+
+  void close();
+};
+
+#endif  // INCLUDE_INCLUDE_FRAMESNAPSHOTBUFFER_HPP_
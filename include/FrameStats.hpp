@@ -0,0 +1,22 @@
+#ifndef INCLUDE_INCLUDE_FRAMESTATS_HPP_
+#define INCLUDE_INCLUDE_FRAMESTATS_HPP_
+
+#include <cstddef>
+#include <vector>
+
+class FrameStats
+{
+ private:
+  std::vector<double> samples;
+
+ public:
+  void add(double milliseconds);
+  void clear() noexcept;
+
+  std::size_t count() const noexcept;
+  double mean() const noexcept;
+  double max() const noexcept;
+  double percentile(double p) const;
+};
+
+#endif  // INCLUDE_INCLUDE_FRAMESTATS_HPP_
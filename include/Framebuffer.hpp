@@ -0,0 +1,33 @@
+#ifndef INCLUDE_INCLUDE_FRAMEBUFFER_HPP_
+#define INCLUDE_INCLUDE_FRAMEBUFFER_HPP_
+
+#include "Image.hpp"
+
+class Framebuffer
+{
+ private:
+  unsigned int fbo, colorTexture, depthRbo;
+  int width, height;
+
+ public:
+  Framebuffer(int width, int height, bool floatDepth = false);
+  ~Framebuffer() noexcept;
+
+  Framebuffer(const Framebuffer& other) = delete;
+  Framebuffer& operator=(const Framebuffer& other) = delete;
+
+  Framebuffer(Framebuffer&& other);
+  Framebuffer& operator=(Framebuffer&& other);
+
+  void bind() const noexcept;
+  void unbind() const noexcept;
+
+  Image readPixels() const;
+
+  unsigned int getId() const noexcept;
+  unsigned int getColorTexture() const noexcept;
+  int getWidth() const noexcept;
+  int getHeight() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_FRAMEBUFFER_HPP_
@@ -0,0 +1,26 @@
+#ifndef INCLUDE_INCLUDE_FRUSTUM_HPP_
+#define INCLUDE_INCLUDE_FRUSTUM_HPP_
+
+#include <array>
+#include <glm/glm.hpp>
+
+struct BoundingSphere
+{
+  glm::vec3 center;
+  float radius;
+};
+
+class Frustum
+{
+ private:
+  std::array<glm::vec4, 6> planes;
+
+ public:
+  explicit Frustum(const glm::mat4& viewProjection) noexcept;
+
+  bool intersects(const BoundingSphere& sphere) const noexcept;
+
+  const std::array<glm::vec4, 6>& getPlanes() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_FRUSTUM_HPP_
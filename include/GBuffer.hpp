@@ -0,0 +1,30 @@
+#ifndef INCLUDE_INCLUDE_GBUFFER_HPP_
+#define INCLUDE_INCLUDE_GBUFFER_HPP_
+
+class GBuffer
+{
+ private:
+  unsigned int fbo;
+  unsigned int albedoTexture, normalTexture, depthTexture;
+  unsigned int vao;
+  int width, height;
+  bool floatDepth;
+
+ public:
+  GBuffer(int width, int height, bool floatDepth = false);
+  ~GBuffer() noexcept;
+
+  GBuffer(const GBuffer& other) = delete;
+  GBuffer& operator=(const GBuffer& other) = delete;
+
+  void resize(int width, int height);
+  void bind() const noexcept;
+
+  void drawLighting(unsigned int firstUnit) const noexcept;
+
+ private:
+  void create();
+  void destroy() noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_GBUFFER_HPP_
@@ -0,0 +1,60 @@
+#ifndef INCLUDE_INCLUDE_GLEXTENSIONS_HPP_
+#define INCLUDE_INCLUDE_GLEXTENSIONS_HPP_
+
+#include "glad/glad.h"
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_NEGATIVE_ONE_TO_ONE
+#define GL_NEGATIVE_ONE_TO_ONE 0x935E
+#endif
+#ifndef GL_ZERO_TO_ONE
+#define GL_ZERO_TO_ONE 0x935F
+#endif
+
+typedef void(APIENTRYP PFNGLBUFFERSTORAGEPROC)(
+    GLenum target,
+    GLsizeiptr size,
+    const void* data,
+    GLbitfield flags);
+typedef void(APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(
+    GLenum mode,
+    GLenum type,
+    const void* indirect,
+    GLsizei drawcount,
+    GLsizei stride);
+typedef void(APIENTRYP PFNGLCLIPCONTROLPROC)(GLenum origin, GLenum depth);
+
+class GLExtensions
+{
+ private:
+  static bool bufferStorage;
+  static bool multiDrawIndirect;
+  static bool clipControl;
+
+ public:
+  static PFNGLBUFFERSTORAGEPROC glBufferStorage;
+  static PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect;
+  static PFNGLCLIPCONTROLPROC glClipControl;
+
+  static void load(GLADloadproc loader);
+
+  static bool hasVersion(int major, int minor) noexcept;
+  static bool hasExtension(const char* name) noexcept;
+
+  static bool hasBufferStorage() noexcept;
+  static bool hasMultiDrawIndirect() noexcept;
+  static bool hasClipControl() noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_GLEXTENSIONS_HPP_
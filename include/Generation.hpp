@@ -0,0 +1,16 @@
+#ifndef INCLUDE_INCLUDE_GENERATION_HPP_
+#define INCLUDE_INCLUDE_GENERATION_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+class Generation
+{
+ private:
+  static std::atomic<std::uint64_t> counter;
+
+ public:
+  static std::uint64_t next() noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_GENERATION_HPP_
@@ -0,0 +1,23 @@
+#ifndef INCLUDE_INCLUDE_GLFWWINDOW_HPP_
+#define INCLUDE_INCLUDE_GLFWWINDOW_HPP_
+
+#include <string>
+
+struct GLFWwindow;
+
+class GlfwWindow
+{
+ private:
+  GLFWwindow* window;
+
+ public:
+  GlfwWindow(int width, int height, const std::string& title);
+  ~GlfwWindow() noexcept;
+
+  GlfwWindow(const GlfwWindow& other) = delete;
+  GlfwWindow& operator=(const GlfwWindow& other) = delete;
+
+  GLFWwindow* get() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_GLFWWINDOW_HPP_
@@ -0,0 +1,75 @@
+#ifndef INCLUDE_INCLUDE_GPUCULLER_HPP_
+#define INCLUDE_INCLUDE_GPUCULLER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "DepthPyramid.hpp"
+#include "Shader.hpp"
+
+struct CullCandidate
+{
+  glm::vec4 sphere;
+  glm::vec4 cone;
+  unsigned int indexCount;
+  unsigned int firstIndex;
+  unsigned int object;
+};
+
+enum class CullPhase
+{
+  PREVIOUSLY_VISIBLE,
+  OCCLUSION_TESTED
+};
+
+class GpuCuller
+{
+ private:
+  static constexpr unsigned int OBJECT_UNIT = 14;
+  static constexpr unsigned int PYRAMID_UNIT = 15;
+
+  Shader cullShader;
+  DepthPyramid pyramid;
+
+  unsigned int candidateBuffer;
+  std::array<unsigned int, 2> commandBuffers;
+  std::array<unsigned int, 2> vaos;
+  unsigned int objectTexture;
+
+  std::size_t candidateCount = 0;
+  int width, height;
+
+ public:
+  GpuCuller(
+      const std::string& shaderDirectory,
+      unsigned int objectBuffer,
+      int width,
+      int height,
+      bool reverseZ = false);
+  ~GpuCuller() noexcept;
+
+  GpuCuller(const GpuCuller& other) = delete;
+  GpuCuller& operator=(const GpuCuller& other) = delete;
+
+  static bool isSupported(std::size_t objectBufferSize) noexcept;
+
+  void resize(int width, int height);
+  void setCandidates(const std::vector<CullCandidate>& candidates);
+
+  void cull(
+      CullPhase phase,
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      std::size_t objectBase,
+      std::size_t objectStride,
+      bool coneCulling);
+  void buildPyramid(unsigned int framebuffer);
+  void bindCommands(CullPhase phase) const noexcept;
+
+  std::size_t getCandidateCount() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_GPUCULLER_HPP_
@@ -0,0 +1,81 @@
+#ifndef INCLUDE_INCLUDE_GPUPROFILER_HPP_
+#define INCLUDE_INCLUDE_GPUPROFILER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Profiler.hpp"
+
+struct GpuTiming
+{
+  const char* name;
+  double milliseconds;
+};
+
+class GpuProfiler
+{
+ private:
+  static constexpr std::size_t FRAME_LATENCY = 3;
+  static constexpr std::size_t MAX_SCOPES = 64;
+  static constexpr std::uint64_t CALIBRATION_INTERVAL = 256;
+
+  struct Scope
+  {
+    const char* name;
+    unsigned int startQuery;
+    unsigned int endQuery;
+    bool closed;
+  };
+
+  struct Frame
+  {
+    std::array<unsigned int, MAX_SCOPES * 2> queries;
+    std::vector<Scope> scopes;
+    std::vector<std::size_t> openScopes;
+    std::size_t droppedScopes = 0;
+    unsigned int lastQuery = 0;
+  };
+
+  std::array<Frame, FRAME_LATENCY> frames;
+  std::uint64_t frameCount = 0;
+  std::int64_t gpuToCpuOffsetNs = 0;
+
+  std::vector<GpuTiming> lastTimings;
+  ProfileBuffer* track = nullptr;
+
+ public:
+  GpuProfiler();
+  ~GpuProfiler() noexcept;
+
+  GpuProfiler(const GpuProfiler& other) = delete;
+  GpuProfiler& operator=(const GpuProfiler& other) = delete;
+
+  void beginFrame();
+
+  void begin(const char* name) noexcept;
+  void end() noexcept;
+
+  const std::vector<GpuTiming>& getLastTimings() const noexcept;
+  double getLastTime(const char* name) const noexcept;
+
+ private:
+  void calibrate() noexcept;
+  void collect(Frame& frame);
+};
+
+class GpuProfileScope
+{
+ private:
+  GpuProfiler& profiler;
+
+ public:
+  GpuProfileScope(GpuProfiler& profiler, const char* name) noexcept;
+  ~GpuProfileScope() noexcept;
+
+  GpuProfileScope(const GpuProfileScope& other) = delete;
+  GpuProfileScope& operator=(const GpuProfileScope& other) = delete;
+};
+
+#endif  // INCLUDE_INCLUDE_GPUPROFILER_HPP_
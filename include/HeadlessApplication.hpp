@@ -0,0 +1,86 @@
+#ifndef INCLUDE_INCLUDE_HEADLESSAPPLICATION_HPP_
+#define INCLUDE_INCLUDE_HEADLESSAPPLICATION_HPP_
+
+#include <optional>
+#include <string>
+
+#include "Application.hpp"
+#include "Camera.hpp"
+#include "CameraPath.hpp"
+#include "EglContext.hpp"
+#include "FrameStats.hpp"
+#include "Framebuffer.hpp"
+#include "Image.hpp"
+#include "JobSystem.hpp"
+#include "Model.hpp"
+#include "Projection.hpp"
+#include "Renderer.hpp"
+
+struct HeadlessOptions
+{
+  int width = 800;
+  int height = 600;
+  int frames = 500;
+  int warmupFrames = 20;
+  std::string modelPath = "./assets/models/backpack/backpack.obj";
+  bool gpuCulling = false;
+  bool depthPrepass = false;
+  bool positionStream = false;
+  bool shadows = false;
+  bool deferred = false;
+  int lights = 0;
+  bool reverseZ = false;
+  bool occluders = false;
+
+  int captureFrame = -1;
+  std::string capturePath;
+  std::string comparePath;
+  double minPsnr = 40.0;
+};
+
+class HeadlessApplication : public Application
+{
+ private:
+  HeadlessOptions options;
+
+  EglContext context;
+  bool reverseZ;
+  Framebuffer framebuffer;
+
+  Camera camera;
+  Projection projection;
+  CameraPath path;
+
+  JobSystem jobs;
+  Model model;
+  Renderer renderer;
+
+  int frame = 0;
+  int totalFrames;
+  int captureFrame;
+  std::optional<Image> capture;
+  FrameStats triangleStats;
+  FrameStats prepassGpuStats;
+  FrameStats shadingGpuStats;
+  FrameStats shadowGpuStats;
+  FrameStats lightingGpuStats;
+
+ public:
+  HeadlessApplication(const HeadlessOptions& options);
+
+  const std::optional<Image>& getCapture() const noexcept;
+  const FrameStats& getTriangleStats() const noexcept;
+  const FrameStats& getPrepassGpuStats() const noexcept;
+  const FrameStats& getShadingGpuStats() const noexcept;
+  const FrameStats& getShadowGpuStats() const noexcept;
+  const FrameStats& getLightingGpuStats() const noexcept;
+
+ protected:
+  bool isRunning() override;
+  void update(double deltaTime) override;
+  void render(double alpha) override;
+  void present() override;
+  void endFrame() override;
+};
+
+#endif  // INCLUDE_INCLUDE_HEADLESSAPPLICATION_HPP_
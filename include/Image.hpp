@@ -0,0 +1,30 @@
+#ifndef INCLUDE_INCLUDE_IMAGE_HPP_
+#define INCLUDE_INCLUDE_IMAGE_HPP_
+
+#include <memory>
+#include <string>
+
+class Image
+{
+ private:
+  using PixelPtr = std::unique_ptr<unsigned char, void (*)(void*)>;
+
+  PixelPtr pixels;
+  int width, height, channels;
+
+ public:
+  Image(const std::string& path);
+  Image(int width, int height, int channels);
+
+  unsigned char* data() const noexcept;
+  int getWidth() const noexcept;
+  int getHeight() const noexcept;
+  int getChannels() const noexcept;
+  std::size_t size() const noexcept;
+
+  void writePng(const std::string& path, bool flipRows) const;
+
+  static double psnr(const Image& a, const Image& b);
+};
+
+#endif  // INCLUDE_INCLUDE_IMAGE_HPP_
@@ -0,0 +1,92 @@
+#ifndef INCLUDE_INCLUDE_JOBSYSTEM_HPP_
+#define INCLUDE_INCLUDE_JOBSYSTEM_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class JobCounter
+{
+ private:
+  friend class JobSystem;
+
+  std::atomic<unsigned int> pending = 0;
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+ public:
+  JobCounter() = default;
+
+  JobCounter(const JobCounter& other) = delete;
+  JobCounter& operator=(const JobCounter& other) = delete;
+
+  bool isDone() const noexcept;
+};
+
+class JobSystem
+{
+ private:
+  struct Job
+  {
+    std::function<void()> task;
+    JobCounter* counter;
+    const JobCounter* dependency;
+  };
+
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+
+  std::mutex blockedMutex;
+  std::vector<Job> blockedJobs;
+
+  std::atomic<bool> running = true;
+  std::atomic<std::size_t> queuedJobs = 0;
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+
+ public:
+  explicit JobSystem(unsigned int workerCount = defaultWorkerCount());
+  ~JobSystem() noexcept;
+
+  JobSystem(const JobSystem& other) = delete;
+  JobSystem& operator=(const JobSystem& other) = delete;
+
+  static unsigned int defaultWorkerCount() noexcept;
+  unsigned int getWorkerCount() const noexcept;
+
+  void submit(std::function<void()> task, JobCounter& counter);
+  void submitAfter(
+      const JobCounter& dependency,
+      std::function<void()> task,
+      JobCounter& counter);
+  void wait(JobCounter& counter);
+
+  void parallelFor(
+      std::size_t count,
+      std::size_t grainSize,
+      const std::function<void(std::size_t, std::size_t)>& body);
+
+ private:
+  std::size_t currentQueue() const noexcept;
+  void push(Job&& job);
+  std::optional<Job> pop(std::size_t queue);
+  bool tryRun(std::size_t queue);
+  void releaseBlocked();
+  void workerLoop(std::size_t queue);
+};
+
+#endif  // INCLUDE_INCLUDE_JOBSYSTEM_HPP_
@@ -0,0 +1,50 @@
+#ifndef INCLUDE_INCLUDE_LIGHTGRID_HPP_
+#define INCLUDE_INCLUDE_LIGHTGRID_HPP_
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct PointLight
+{
+  glm::vec3 position;
+  float radius;
+  glm::vec3 color;
+};
+
+class LightGrid
+{
+ public:
+  static constexpr int TILE_SIZE = 16;
+
+ private:
+  unsigned int lightBuffer, lightTexture;
+  unsigned int tileBuffer, tileTexture;
+  int width, height;
+  int tilesX, tilesY;
+
+  std::vector<glm::vec4> lightData;
+  std::vector<std::vector<unsigned int>> bins;
+  std::vector<unsigned int> tileData;
+  std::size_t lightCount = 0;
+
+ public:
+  LightGrid(int width, int height);
+  ~LightGrid() noexcept;
+
+  LightGrid(const LightGrid& other) = delete;
+  LightGrid& operator=(const LightGrid& other) = delete;
+
+  void resize(int width, int height);
+  void build(
+      const std::vector<PointLight>& lights,
+      const glm::mat4& view,
+      const glm::mat4& projection);
+
+  unsigned int getLightTexture() const noexcept;
+  unsigned int getTileTexture() const noexcept;
+  int getTilesX() const noexcept;
+  std::size_t getLightCount() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_LIGHTGRID_HPP_
@@ -1,12 +1,17 @@
 #ifndef INCLUDE_INCLUDE_MESH_HPP_
 #define INCLUDE_INCLUDE_MESH_HPP_
 
+#include <cstddef>
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
 
+#include "CommandBuffer.hpp"
+#include "Frustum.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "TextureBinder.hpp"
 
 struct Vertex
 {
@@ -15,22 +20,53 @@ struct Vertex
   glm::vec2 texCoords;
 };
 
+struct MeshLod
+{
+  unsigned int firstIndex;
+  unsigned int indexCount;
+  float error;
+};
+
+struct Meshlet
+{
+  unsigned int firstIndex;
+  unsigned int indexCount;
+  BoundingSphere bounds;
+  glm::vec3 coneAxis;
+  float coneCutoff;
+};
+
 class Mesh
 {
  private:
   using TextureVector = std::vector<std::shared_ptr<Texture>>;
+  using TextureLayerVector = std::vector<TextureLayer>;
+  using LodVector = std::vector<MeshLod>;
+  using MeshletVector = std::vector<Meshlet>;
 
   unsigned int vao, vbo, ebo;
+  unsigned int positionVao = 0, positionVbo = 0;
 
   std::vector<Vertex> vertices;
+  std::vector<glm::vec3> positions;
   std::vector<unsigned int> indices;
   TextureVector textures;
+  TextureLayerVector textureLayers;
+  LodVector lods;
+  MeshletVector meshlets;
+  BoundingSphere bounds;
 
  public:
+  static constexpr unsigned int MAX_MATERIAL_TEXTURES = 4;
+
   Mesh(
       std::vector<Vertex>&& vertices,
       std::vector<unsigned int>&& indices,
-      TextureVector&& textures);
+      TextureVector&& textures,
+      TextureLayerVector&& textureLayers = {},
+      LodVector&& lods = {},
+      MeshletVector&& meshlets = {},
+      bool positionStream = false);
   ~Mesh() noexcept;
 
   Mesh(const Mesh& other) = delete;
@@ -40,6 +76,41 @@ class Mesh
   Mesh& operator=(Mesh&& other);
 
   void draw(const Shader& shader) const;
+  void draw(const Shader& shader, TextureBinder& binder) const;
+  void record(
+      const Shader& shader,
+      CommandBuffer& commands,
+      std::size_t lod = 0) const;
+  void recordMultiDraw(
+      const Shader& shader,
+      CommandBuffer& commands,
+      std::size_t rangeSlot) const;
+  void recordIndirect(
+      const Shader& shader,
+      CommandBuffer& commands,
+      std::size_t firstCommand,
+      unsigned int commandCount) const;
+
+  unsigned int getIndexCount(std::size_t lod = 0) const noexcept;
+  const std::vector<Vertex>& getVertices() const noexcept;
+  const std::vector<glm::vec3>& getPositions() const noexcept;
+  bool hasPositionStream() const noexcept;
+  const std::vector<unsigned int>& getIndices() const noexcept;
+  const LodVector& getLods() const noexcept;
+  const MeshletVector& getMeshlets() const noexcept;
+  const BoundingSphere& getBounds() const noexcept;
+  const TextureVector& getTextures() const noexcept;
+  const TextureLayerVector& getTextureLayers() const noexcept;
+  glm::vec4 getMaterialLayers() const noexcept;
+
+  static unsigned int materialUnit(
+      Texture::Type type,
+      unsigned int number) noexcept;
+  static void setMaterialSamplers(const Shader& shader);
+
+ private:
+  void createPositionStream();
+  void recordMaterial(const Shader& shader, CommandBuffer& commands) const;
 };
 
 #endif  // INCLUDE_INCLUDE_MESH_HPP_
@@ -0,0 +1,33 @@
+#ifndef INCLUDE_INCLUDE_MESHSIMPLIFIER_HPP_
+#define INCLUDE_INCLUDE_MESHSIMPLIFIER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "Mesh.hpp"
+
+struct SimplifiedIndices
+{
+  std::vector<unsigned int> indices;
+  float error;
+};
+
+class MeshSimplifier
+{
+ public:
+  static constexpr std::size_t MAX_LODS = 4;
+  static constexpr float LOD_REDUCTION = 0.5F;
+  static constexpr float MIN_LOD_PROGRESS = 0.9F;
+  static constexpr std::size_t MIN_LOD_TRIANGLES = 64;
+
+  static SimplifiedIndices simplify(
+      const std::vector<Vertex>& vertices,
+      const std::vector<unsigned int>& indices,
+      std::size_t targetIndexCount);
+
+  static std::vector<MeshLod> generateLods(
+      const std::vector<Vertex>& vertices,
+      std::vector<unsigned int>& indices);
+};
+
+#endif  // INCLUDE_INCLUDE_MESHSIMPLIFIER_HPP_
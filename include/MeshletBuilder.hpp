@@ -0,0 +1,28 @@
+#ifndef INCLUDE_INCLUDE_MESHLETBUILDER_HPP_
+#define INCLUDE_INCLUDE_MESHLETBUILDER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "Mesh.hpp"
+
+class MeshletBuilder
+{
+ public:
+  static constexpr std::size_t MAX_VERTICES = 64;
+  static constexpr std::size_t MAX_TRIANGLES = 124;
+
+  static std::vector<Meshlet> build(
+      const std::vector<Vertex>& vertices,
+      const std::vector<unsigned int>& indices,
+      std::size_t indexCount);
+
+ private:
+  static Meshlet finish(
+      const std::vector<Vertex>& vertices,
+      const std::vector<unsigned int>& indices,
+      std::size_t firstIndex,
+      std::size_t indexCount);
+};
+
+#endif  // INCLUDE_INCLUDE_MESHLETBUILDER_HPP_
@@ -3,39 +3,128 @@
 
 #include <assimp/scene.h>
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "CommandBuffer.hpp"
+#include "Image.hpp"
+#include "JobSystem.hpp"
 #include "Mesh.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "TextureStreamer.hpp"
+
+struct TextureBindReport
+{
+  unsigned int unpackedBinds;
+  unsigned int packedBinds;
+};
 
 class Model
 {
  private:
+  friend class ModelBuilder;
+
   using TextureVector = std::vector<std::shared_ptr<Texture>>;
   using TextureMap = std::unordered_map<std::string, std::shared_ptr<Texture>>;
+  using TextureRefVector = std::vector<std::pair<std::string, Texture::Type>>;
+  using ImageMap = std::unordered_map<std::string, Image>;
+
+  struct PendingMesh
+  {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    TextureRefVector textureRefs;
+    std::vector<MeshLod> lods;
+    std::vector<Meshlet> meshlets;
+  };
 
   std::vector<Mesh> meshes;
   std::filesystem::path directory;
   TextureMap loadedTextures;
 
- public:
-  Model(const std::string& path);
+  bool packTextures;
+  bool generateLods;
+  bool positionStream;
+  TextureStreamer* streamer;
+  JobSystem* jobs;
+  std::vector<PendingMesh> pendingMeshes;
+  TextureBindReport bindReport;
+
+  Model(
+      const std::string& path,
+      bool packTextures,
+      bool generateLods,
+      bool positionStream,
+      TextureStreamer* streamer,
+      JobSystem* jobs);
 
+ public:
   void draw(const Shader& shader) const noexcept;
+  void record(const Shader& shader, CommandBuffer& commands) const;
+
+  const std::vector<Mesh>& getMeshes() const noexcept;
+  bool hasPackedTextures() const noexcept;
+  TextureBindReport getTextureBindReport() const noexcept;
+
+  static std::vector<Vertex> convertVertices(const aiMesh* mesh);
+  static std::vector<unsigned int> convertIndices(const aiMesh* mesh);
 
  private:
-  void processNode(aiNode* node, const aiScene* scene);
-  void processMesh(aiMesh* mesh, const aiScene* scene);
-  void loadMaterialTexture(
-      aiMaterial* mat,
+  void processNode(
+      const aiNode* node,
+      const aiScene* scene,
+      std::vector<const aiMesh*>& sceneMeshes) const;
+  PendingMesh processMesh(const aiMesh* mesh, const aiScene* scene) const;
+  void collectMaterialTexture(
+      const aiMaterial* mat,
       aiTextureType aiTexType,
       Texture::Type texType,
-      TextureVector& textures);
+      TextureRefVector& textureRefs) const;
+  std::vector<std::string> pendingTextureNames() const;
+  ImageMap decodeImages(const std::vector<std::string>& names) const;
+  std::shared_ptr<Texture> loadTexture(
+      const std::string& name,
+      Texture::Type type,
+      const ImageMap& images);
+  void uploadPendingMeshes();
+  void packPendingMeshes();
+  void parallelFor(
+      std::size_t count,
+      const std::function<void(std::size_t)>& body) const;
+  void computeBindReport() noexcept;
+};
+
+class ModelBuilder
+{
+ private:
+  std::string path;
+  bool packTextures = DEFAULT_PACK_TEXTURES;
+  bool generateLods = DEFAULT_GENERATE_LODS;
+  bool positionStream = DEFAULT_POSITION_STREAM;
+  TextureStreamer* streamer = nullptr;
+  JobSystem* jobs = nullptr;
+
+ public:
+  static constexpr bool DEFAULT_PACK_TEXTURES = false;
+  static constexpr bool DEFAULT_GENERATE_LODS = true;
+  static constexpr bool DEFAULT_POSITION_STREAM = false;
+
+  ModelBuilder& fromFile(const std::string& path);
+  ModelBuilder& withTexturePacking(bool packTextures) noexcept;
+  ModelBuilder& withLodGeneration(bool generateLods) noexcept;
+  ModelBuilder& withPositionStream(bool positionStream) noexcept;
+  ModelBuilder& withTextureStreamer(TextureStreamer& streamer) noexcept;
+  ModelBuilder& withJobSystem(JobSystem& jobs) noexcept;
+
+  Model build() const;
 };
 
 #endif  // INCLUDE_INCLUDE_MODEL_HPP_
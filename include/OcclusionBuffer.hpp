@@ -0,0 +1,77 @@
+#ifndef INCLUDE_INCLUDE_OCCLUSIONBUFFER_HPP_
+#define INCLUDE_INCLUDE_OCCLUSIONBUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "JobSystem.hpp"
+#include "Mesh.hpp"
+
+class OcclusionBuffer
+{
+ private:
+  struct ScreenTriangle
+  {
+    std::array<glm::vec3, 3> vertices;
+    int minX, minY, maxX, maxY;
+  };
+
+  int width, height;
+  int tilesX, tilesY;
+  JobSystem* jobs;
+
+  std::vector<ScreenTriangle> triangles;
+  std::vector<std::vector<unsigned int>> bins;
+  std::vector<std::vector<float>> levels;
+
+ public:
+  static constexpr int DEFAULT_WIDTH = 256;
+  static constexpr int DEFAULT_HEIGHT = 128;
+  static constexpr int TILE_WIDTH = 64;
+  static constexpr int TILE_HEIGHT = 32;
+  static constexpr int MAX_TEST_TEXELS = 4;
+  static constexpr float NEAR_W = 1e-4F;
+
+  explicit OcclusionBuffer(
+      int width = DEFAULT_WIDTH,
+      int height = DEFAULT_HEIGHT,
+      JobSystem* jobs = nullptr);
+
+  void clear();
+  void addOccluder(
+      const std::vector<Vertex>& vertices,
+      const std::vector<unsigned int>& indices,
+      std::size_t indexCount,
+      const glm::mat4& modelViewProjection);
+  void addOccluder(
+      const std::vector<glm::vec3>& positions,
+      const std::vector<unsigned int>& indices,
+      std::size_t indexCount,
+      const glm::mat4& modelViewProjection);
+  void finish();
+
+  bool isVisible(
+      const BoundingSphere& bounds,
+      const glm::mat4& modelViewProjection) const noexcept;
+
+  int getWidth() const noexcept;
+  int getHeight() const noexcept;
+  float getDepth(int x, int y, std::size_t level = 0) const noexcept;
+  std::size_t getLevelCount() const noexcept;
+  std::size_t getTriangleCount() const noexcept;
+
+ private:
+  template <typename PositionAt>
+  void addTriangles(
+      PositionAt positionAt,
+      const std::vector<unsigned int>& indices,
+      std::size_t indexCount,
+      const glm::mat4& modelViewProjection);
+  void rasterizeTile(std::size_t tile);
+  void buildHierarchy();
+};
+
+#endif  // INCLUDE_INCLUDE_OCCLUSIONBUFFER_HPP_
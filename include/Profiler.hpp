@@ -0,0 +1,120 @@
+#ifndef INCLUDE_INCLUDE_PROFILER_HPP_
+#define INCLUDE_INCLUDE_PROFILER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfileEvent
+{
+  const char* name;
+  std::uint64_t startNs;
+  std::uint64_t endNs;
+};
+
+class ProfileBuffer
+{
+ private:
+  static constexpr std::size_t CAPACITY = 1 << 16;
+
+  struct Slot
+  {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<const char*> name;
+    std::atomic<std::uint64_t> startNs;
+    std::atomic<std::uint64_t> endNs;
+  };
+
+  std::array<Slot, CAPACITY> events;
+  std::atomic<std::uint64_t> head = 0;
+  std::uint32_t threadId;
+  std::atomic<const char*> threadName = nullptr;
+
+ public:
+  ProfileBuffer(std::uint32_t threadId) noexcept;
+
+  void push(const ProfileEvent& event) noexcept;
+  std::vector<ProfileEvent> snapshot() const;
+
+  std::uint32_t getThreadId() const noexcept;
+  const char* getThreadName() const noexcept;
+  void setThreadName(const char* name) noexcept;
+  void reset(std::uint32_t threadId) noexcept;
+};
+
+class Profiler
+{
+ private:
+  struct ThreadBufferHandle;
+
+  struct RetiredTrack
+  {
+    std::uint32_t threadId;
+    const char* threadName;
+    std::vector<ProfileEvent> events;
+  };
+
+  static std::mutex registryMutex;
+  static std::vector<std::unique_ptr<ProfileBuffer>> buffers;
+  static std::vector<ProfileBuffer*> freeBuffers;
+  static std::vector<RetiredTrack> retiredTracks;
+  static std::uint32_t nextThreadId;
+  static std::uint64_t lastFrameNs;
+
+ public:
+  static std::uint64_t now() noexcept;
+
+  static ProfileBuffer& threadBuffer();
+  static ProfileBuffer& createTrack(const char* name);
+  static void record(
+      const char* name,
+      std::uint64_t startNs,
+      std::uint64_t endNs);
+  static void setThreadName(const char* name);
+  static void markFrame();
+
+  static void exportChromeTrace(const std::string& path);
+
+ private:
+  static ProfileBuffer* acquireBuffer();
+  static void releaseBuffer(ProfileBuffer* buffer) noexcept;
+};
+
+class ProfileScope
+{
+ private:
+  ProfileBuffer& buffer;
+  const char* name;
+  std::uint64_t startNs;
+
+ public:
+  ProfileScope(const char* name);
+  ~ProfileScope() noexcept;
+
+  ProfileScope(const ProfileScope& other) = delete;
+  ProfileScope& operator=(const ProfileScope& other) = delete;
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b)      PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) \
+  ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION()          PROFILE_SCOPE(__func__)
+#define PROFILE_THREAD(name)        Profiler::setThreadName(name)
+#define PROFILE_FRAME()             Profiler::markFrame()
+#define PROFILE_EXPORT(path)        Profiler::exportChromeTrace(path)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_THREAD(name)
+#define PROFILE_FRAME()
+#define PROFILE_EXPORT(path)
+#endif
+
+#endif  // INCLUDE_INCLUDE_PROFILER_HPP_
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_INCLUDE_PROJECTION_HPP_
 #define INCLUDE_INCLUDE_PROJECTION_HPP_
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 class Projection
@@ -16,6 +17,13 @@ class Projection
 
   float near;
   float far;
+  bool reverseZ;
+
+  std::uint64_t generation;
+
+  mutable std::uint64_t matrixGeneration = 0;
+  mutable glm::mat4 projection;
+  mutable glm::mat4 inverseProjection;
 
   Projection(
       float fov,
@@ -23,14 +31,21 @@ class Projection
       float maxFov,
       float aspectRatio,
       float near,
-      float far) noexcept;
+      float far,
+      bool reverseZ) noexcept;
 
  public:
   void setFovRange(float min, float max) noexcept;
   void setFov(float fov) noexcept;
   void updateFov(float yoffset) noexcept;
 
-  glm::mat4 getProjectionMatrix() const;
+  const glm::mat4& getProjectionMatrix() const;
+  const glm::mat4& getInverseProjectionMatrix() const;
+  bool isReverseZ() const noexcept;
+  std::uint64_t getGeneration() const noexcept;
+
+ private:
+  void _updateMatrices() const;
 };
 
 class ProjectionBuilder
@@ -42,6 +57,7 @@ class ProjectionBuilder
   float near = DEFAULT_NEAR;
   float far = DEFAULT_FAR;
   float aspectRatio = -1.0F;
+  bool reverseZ = false;
 
  public:
   static constexpr float DEFAULT_FOV = 45.0F;
@@ -55,6 +71,7 @@ class ProjectionBuilder
   ProjectionBuilder& withFovRange(float min, float max) noexcept;
   ProjectionBuilder& withAspectRatio(float aspectRatio) noexcept;
   ProjectionBuilder& withZRange(float near, float far) noexcept;
+  ProjectionBuilder& withReverseZ(bool reverseZ) noexcept;
 
   Projection build() const;
 };
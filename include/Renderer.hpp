@@ -0,0 +1,270 @@
+#ifndef INCLUDE_INCLUDE_RENDERER_HPP_
+#define INCLUDE_INCLUDE_RENDERER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Camera.hpp"
+#include "CascadedShadowMap.hpp"
+#include "CommandBuffer.hpp"
+#include "GBuffer.hpp"
+#include "GpuCuller.hpp"
+#include "GpuProfiler.hpp"
+#include "JobSystem.hpp"
+#include "LightGrid.hpp"
+#include "Mesh.hpp"
+#include "Model.hpp"
+#include "OcclusionBuffer.hpp"
+#include "Projection.hpp"
+#include "RingBuffer.hpp"
+#include "Shader.hpp"
+
+struct RenderInstance
+{
+  const Model* model;
+  glm::mat4 transform;
+  bool occluder = false;
+
+  bool operator==(const RenderInstance& other) const = default;
+};
+
+struct DirectionalLight
+{
+  glm::vec3 direction;
+  glm::vec3 ambient;
+  glm::vec3 diffuse;
+  glm::vec3 specular;
+};
+
+enum class ShadingMode
+{
+  FORWARD,
+  DEFERRED
+};
+
+struct RenderStats
+{
+  unsigned int drawCalls;
+  unsigned int triangles;
+  unsigned int visibleMeshlets;
+  unsigned int totalMeshlets;
+  unsigned int occludedMeshlets;
+};
+
+class Renderer
+{
+ private:
+  friend class RendererBuilder;
+
+  static constexpr unsigned int FRAME_BINDING = 0;
+  static constexpr unsigned int OBJECT_BINDING = 1;
+  static constexpr std::size_t DYNAMIC_FRAME_CAPACITY = 1 << 20;
+  static constexpr float LOD_PIXEL_ERROR = 1.0F;
+  static constexpr std::size_t CULL_GRAIN_SIZE = 8;
+  static constexpr std::size_t RECORD_GRAIN_SIZE = 16;
+  static constexpr unsigned int SHADOW_UNIT = 13;
+  static constexpr unsigned int LIGHT_UNIT = 12;
+  static constexpr unsigned int TILE_UNIT = 11;
+  static constexpr unsigned int GBUFFER_UNIT = 0;
+  static constexpr float SHININESS = 32.0F;
+  static constexpr float SHADOW_DISTANCE = 100.0F;
+  static constexpr std::array<const char*, CascadedShadowMap::CASCADE_COUNT>
+      CASCADE_SCOPES = { "ShadowCascade0",
+                         "ShadowCascade1",
+                         "ShadowCascade2",
+                         "ShadowCascade3" };
+
+  struct CulledDraw
+  {
+    const Mesh* mesh;
+    std::size_t instance;
+    unsigned char level;
+  };
+
+  Shader sceneShader;
+  Shader depthShader;
+  GpuProfiler gpuProfiler;
+  RingBuffer dynamicUniforms;
+  std::size_t objectStride;
+  JobSystem* jobs;
+
+  std::vector<RenderInstance> instances;
+  RenderStats stats;
+
+  CommandBuffer commands;
+  std::vector<CommandBuffer> recordChunks;
+  std::vector<RenderInstance> recordedInstances;
+  RenderStats recordedStats;
+  bool commandsValid = false;
+
+  std::uint64_t culledViewGeneration = 0;
+  std::uint64_t culledProjectionGeneration = 0;
+
+  bool lodSelection = true;
+  std::vector<unsigned char> lodLevels;
+  std::vector<unsigned char> recordedLodLevels;
+
+  bool meshletCulling = true;
+  std::vector<CulledDraw> culledDraws;
+  std::vector<IndexRanges> culledRanges;
+  std::vector<RenderStats> culledStats;
+
+  bool occlusionCulling = true;
+  bool occludersRendered = false;
+  OcclusionBuffer occlusionBuffer;
+
+  std::unique_ptr<GpuCuller> gpuCuller;
+
+  bool depthPrepass = false;
+  bool backFaceCulling = true;
+
+  std::unique_ptr<CascadedShadowMap> shadowMap;
+  std::array<CommandBuffer, CascadedShadowMap::CASCADE_COUNT> shadowCommands;
+  std::array<std::size_t, CascadedShadowMap::CASCADE_COUNT> cascadeFrameOffsets;
+  DirectionalLight light;
+
+  std::unique_ptr<LightGrid> lightGrid;
+  std::vector<PointLight> pointLights;
+
+  std::unique_ptr<GBuffer> gBuffer;
+  std::unique_ptr<Shader> gBufferShader;
+  std::unique_ptr<Shader> lightingShader;
+  ShadingMode shadingMode = ShadingMode::FORWARD;
+
+  bool reverseZ = false;
+
+  glm::vec4 clearColor;
+  int width, height;
+
+  Renderer(
+      const std::string& shaderDirectory,
+      bool packedTextures,
+      glm::vec4 clearColor,
+      int width,
+      int height,
+      JobSystem* jobs,
+      bool gpuCulling,
+      bool shadows,
+      bool deferredShading,
+      bool reverseZ);
+
+ public:
+  void addInstance(
+      const Model& model,
+      const glm::mat4& transform,
+      bool occluder = false);
+  void clearInstances() noexcept;
+  void invalidateCommands() noexcept;
+  void setLodSelection(bool enabled) noexcept;
+  void setMeshletCulling(bool enabled) noexcept;
+  void setOcclusionCulling(bool enabled) noexcept;
+  void setDepthPrepass(bool enabled) noexcept;
+  void setBackFaceCulling(bool enabled) noexcept;
+  void setDirectionalLight(const DirectionalLight& light) noexcept;
+  void addPointLight(const PointLight& light);
+  void clearPointLights() noexcept;
+  void setShadingMode(ShadingMode mode) noexcept;
+
+  void resize(int width, int height);
+  void render(const Camera& camera, const Projection& projection);
+  void render(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      const std::vector<RenderInstance>& instances,
+      std::uint64_t viewGeneration = 0,
+      std::uint64_t projectionGeneration = 0);
+
+  const RenderStats& getStats() const noexcept;
+  const CommandBuffer& getCommands() const noexcept;
+  const OcclusionBuffer& getOcclusionBuffer() const noexcept;
+  bool hasGpuCulling() const noexcept;
+  bool hasShadows() const noexcept;
+  bool hasDeferredShading() const noexcept;
+  bool hasReverseZ() const noexcept;
+  ShadingMode getShadingMode() const noexcept;
+  GpuProfiler& getGpuProfiler() noexcept;
+
+ private:
+  void invalidateCulling() noexcept;
+  void selectLods(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      const std::vector<RenderInstance>& instances);
+  void record(const std::vector<RenderInstance>& instances);
+  void recordCandidates(
+      const Mesh& mesh,
+      std::size_t object,
+      unsigned char level,
+      std::vector<CullCandidate>& candidates) const;
+  void renderOccluders(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      const std::vector<RenderInstance>& instances);
+  void cull(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      const std::vector<RenderInstance>& instances);
+  void updateShadows(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      const std::vector<RenderInstance>& instances);
+  void drawShadows(std::size_t objectBase);
+  void setDepthConvention(bool reversed) const noexcept;
+  void setLightUniforms(const Shader& shader, const glm::mat4& view) const;
+  void drawLighting(const glm::mat4& view, const glm::mat4& projection) const;
+  void executeCommands(
+      std::size_t objectBase,
+      const std::vector<IndexRanges>* ranges,
+      bool depthOnly) const;
+  void drawGpuCulled(
+      const glm::mat4& view,
+      const glm::mat4& projection,
+      std::size_t objectBase,
+      bool depthOnly);
+  void drawShading(std::size_t objectBase) const;
+};
+
+class RendererBuilder
+{
+ private:
+  std::string shaderDirectory = DEFAULT_SHADER_DIRECTORY;
+  bool packedTextures = false;
+  glm::vec4 clearColor = DEFAULT_CLEAR_COLOR;
+  int width = -1;
+  int height = -1;
+  JobSystem* jobs = nullptr;
+  bool gpuCulling = false;
+  bool shadows = false;
+  bool deferredShading = false;
+  bool reverseZ = false;
+
+ public:
+  static constexpr const char* DEFAULT_SHADER_DIRECTORY = "./shaders";
+  static constexpr glm::vec4 DEFAULT_CLEAR_COLOR =
+      glm::vec4(0.05F, 0.05F, 0.05F, 1.0F);
+  static constexpr DirectionalLight DEFAULT_LIGHT = {
+    glm::vec3(-0.4F, -1.0F, -0.3F),
+    glm::vec3(0.25F),
+    glm::vec3(0.8F),
+    glm::vec3(0.3F)
+  };
+
+  RendererBuilder& withShaderDirectory(const std::string& directory);
+  RendererBuilder& withPackedTextures(bool packedTextures) noexcept;
+  RendererBuilder& withClearColor(glm::vec4 clearColor) noexcept;
+  RendererBuilder& withViewport(int width, int height) noexcept;
+  RendererBuilder& withJobSystem(JobSystem& jobs) noexcept;
+  RendererBuilder& withGpuCulling(bool gpuCulling) noexcept;
+  RendererBuilder& withShadows(bool shadows) noexcept;
+  RendererBuilder& withDeferredShading(bool deferredShading) noexcept;
+  RendererBuilder& withReverseZ(bool reverseZ) noexcept;
+
+  Renderer build() const;
+};
+
+#endif  // INCLUDE_INCLUDE_RENDERER_HPP_
@@ -0,0 +1,49 @@
+#ifndef INCLUDE_INCLUDE_RINGBUFFER_HPP_
+#define INCLUDE_INCLUDE_RINGBUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+
+struct RingAllocation
+{
+  unsigned char* data;
+  std::size_t offset;
+  std::size_t size;
+};
+
+class RingBuffer
+{
+ private:
+  static constexpr std::size_t FRAME_COUNT = 3;
+
+  unsigned int buffer = 0;
+  unsigned int target;
+  std::size_t frameCapacity;
+  std::size_t alignment;
+  bool persistent;
+
+  unsigned char* mapped = nullptr;
+  std::array<void*, FRAME_COUNT> fences {};
+  std::size_t frameIndex = 0;
+  std::size_t frameBase = 0;
+  std::size_t head = 0;
+
+ public:
+  RingBuffer(unsigned int target, std::size_t frameCapacity);
+  ~RingBuffer() noexcept;
+
+  RingBuffer(const RingBuffer& other) = delete;
+  RingBuffer& operator=(const RingBuffer& other) = delete;
+
+  void beginFrame();
+  RingAllocation allocate(std::size_t size);
+  void flush();
+  void endFrame();
+
+  unsigned int getId() const noexcept;
+  std::size_t getSize() const noexcept;
+  std::size_t getAlignment() const noexcept;
+  bool isPersistent() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_RINGBUFFER_HPP_
@@ -3,6 +3,7 @@
 
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
 class Shader
 {
@@ -11,6 +12,9 @@ class Shader
 
  public:
   Shader(const std::string& vertexPath, const std::string& fragmentPath);
+  Shader(
+      const std::string& vertexPath,
+      const std::vector<std::string>& feedbackVaryings);
   ~Shader() noexcept;
 
   Shader(const Shader& other) = delete;
@@ -23,6 +27,9 @@ class Shader
   void unbind() const noexcept;
 
   unsigned int getProgramId() const noexcept;
+  int getUniformLocation(const std::string& name) const noexcept;
+  void setUniformBlockBinding(const std::string& name, unsigned int binding)
+      const noexcept;
 
   void setInt(const std::string& name, int value) const noexcept;
   void setFloat(const std::string& name, float value) const noexcept;
@@ -44,6 +51,8 @@ class Shader
   void setMat4(const std::string& name, glm::mat4 mat) const noexcept;
 
  private:
+  static std::string readFile(const std::string& path);
+  unsigned int compile(unsigned int type, const std::string& path) const;
   void checkStatus(unsigned int id, const std::string& type) const;
 };
 
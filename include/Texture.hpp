@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "Image.hpp"
+
 class Texture
 {
  private:
@@ -16,6 +18,8 @@ class Texture
   };
 
   Texture(const std::string& path, Type type);
+  Texture(const Image& image, Type type);
+  Texture(int width, int height, int channels, Type type);
   ~Texture() noexcept;
 
   Texture(const Texture& other) = delete;
@@ -28,6 +32,9 @@ class Texture
   Type getType() const noexcept;
   std::string typeStr() const noexcept;
 
+  static std::string typeStr(Type type) noexcept;
+  static unsigned int formatFromChannels(int channels) noexcept;
+
  private:
   Type textureType;
 };
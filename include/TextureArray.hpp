@@ -0,0 +1,40 @@
+#ifndef INCLUDE_INCLUDE_TEXTUREARRAY_HPP_
+#define INCLUDE_INCLUDE_TEXTUREARRAY_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "Image.hpp"
+#include "Texture.hpp"
+
+class TextureArray
+{
+ private:
+  unsigned int textureId;
+  int width, height, channels;
+  int layers;
+
+ public:
+  TextureArray(const std::vector<const Image*>& images);
+  ~TextureArray() noexcept;
+
+  TextureArray(const TextureArray& other) = delete;
+  TextureArray& operator=(const TextureArray& other) = delete;
+
+  TextureArray(TextureArray&& other);
+  TextureArray& operator=(TextureArray&& other);
+
+  unsigned int getId() const noexcept;
+  int getLayerCount() const noexcept;
+
+  static int maxLayers() noexcept;
+};
+
+struct TextureLayer
+{
+  std::shared_ptr<TextureArray> array;
+  int layer;
+  Texture::Type type;
+};
+
+#endif  // INCLUDE_INCLUDE_TEXTUREARRAY_HPP_
@@ -0,0 +1,22 @@
+#ifndef INCLUDE_INCLUDE_TEXTUREBINDER_HPP_
+#define INCLUDE_INCLUDE_TEXTUREBINDER_HPP_
+
+#include <array>
+
+class TextureBinder
+{
+ private:
+  static constexpr unsigned int MAX_UNITS = 16;
+
+  std::array<unsigned int, MAX_UNITS> boundIds {};
+  unsigned int bindCount = 0;
+  unsigned int skipCount = 0;
+
+ public:
+  void bind(unsigned int unit, unsigned int target, unsigned int id) noexcept;
+
+  unsigned int getBindCount() const noexcept;
+  unsigned int getSkipCount() const noexcept;
+};
+
+#endif  // INCLUDE_INCLUDE_TEXTUREBINDER_HPP_
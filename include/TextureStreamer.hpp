@@ -0,0 +1,61 @@
+#ifndef INCLUDE_INCLUDE_TEXTURESTREAMER_HPP_
+#define INCLUDE_INCLUDE_TEXTURESTREAMER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "Texture.hpp"
+
+class TextureStreamer
+{
+ private:
+  static constexpr std::size_t SLOT_COUNT = 4;
+
+  struct Request
+  {
+    std::shared_ptr<Texture> texture;
+    std::string path;
+    int width, height, channels;
+  };
+
+  struct Slot
+  {
+    unsigned int pbo = 0;
+    std::size_t capacity = 0;
+    unsigned char* mapped = nullptr;
+    void* fence = nullptr;
+    bool busy = false;
+
+    Request request;
+    std::future<bool> decoded;
+  };
+
+  std::array<Slot, SLOT_COUNT> slots;
+  std::deque<Request> queue;
+  bool persistent;
+
+ public:
+  TextureStreamer();
+  ~TextureStreamer() noexcept;
+
+  TextureStreamer(const TextureStreamer& other) = delete;
+  TextureStreamer& operator=(const TextureStreamer& other) = delete;
+
+  std::shared_ptr<Texture> load(const std::string& path, Texture::Type type);
+
+  void update();
+  void finish();
+  bool isIdle() const noexcept;
+
+ private:
+  void beginUpload(Slot& slot, Request&& request);
+  void endUpload(Slot& slot);
+  void retire(Slot& slot, bool wait) noexcept;
+  void reserve(Slot& slot, std::size_t size);
+};
+
+#endif  // INCLUDE_INCLUDE_TEXTURESTREAMER_HPP_
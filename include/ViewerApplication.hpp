@@ -0,0 +1,102 @@
+#ifndef INCLUDE_INCLUDE_VIEWERAPPLICATION_HPP_
+#define INCLUDE_INCLUDE_VIEWERAPPLICATION_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "Application.hpp"
+#include "Camera.hpp"
+#include "FramePacer.hpp"
+#include "FrameSnapshotBuffer.hpp"
+#include "FrameStats.hpp"
+#include "GlfwWindow.hpp"
+#include "JobSystem.hpp"
+#include "Model.hpp"
+#include "Projection.hpp"
+#include "Renderer.hpp"
+#include "TextureStreamer.hpp"
+
+class ViewerApplication : public Application
+{
+ private:
+  static constexpr int WINDOW_WIDTH = 800;
+  static constexpr int WINDOW_HEIGHT = 600;
+  static constexpr const char* WINDOW_TITLE = "Hello OpenGL";
+  static constexpr bool PACK_TEXTURES = false;
+  static constexpr bool MODEL_OCCLUDES = true;
+  static constexpr SwapMode DEFAULT_SWAP_MODE = SwapMode::VSYNC;
+  static constexpr double FRAME_LIMIT_FPS = 120.0;
+  static constexpr double STATS_INTERVAL = 1.0;
+
+  GlfwWindow window;
+
+  Camera camera;
+  CameraState previousCameraState;
+  Camera renderCamera;
+  Projection projection;
+
+  JobSystem jobs;
+  TextureStreamer textureStreamer;
+  Model model;
+  Renderer renderer;
+
+  std::vector<RenderInstance> scene;
+  std::uint64_t frame = 0;
+  int viewportWidth = WINDOW_WIDTH, viewportHeight = WINDOW_HEIGHT;
+
+  FrameSnapshotBuffer snapshots;
+  std::thread renderThread;
+  FrameStats latencyStats;
+  std::atomic<unsigned int> renderedTriangles = 0;
+
+  SwapMode swapMode = DEFAULT_SWAP_MODE;
+  FrameStats recentFrames;
+  double recentFramesElapsed = 0.0;
+  bool swapKeyDown = false, limiterKeyDown = false;
+
+  bool hasPendingInput = false;
+  std::chrono::steady_clock::time_point pendingInputTime;
+
+  bool firstMouse = true;
+  double lastCursorX = 0.0, lastCursorY = 0.0;
+
+ public:
+  ViewerApplication();
+  ~ViewerApplication() override;
+
+  ViewerApplication(const ViewerApplication& other) = delete;
+  ViewerApplication& operator=(const ViewerApplication& other) = delete;
+
+  const FrameStats& getLatencyStats() const noexcept;
+
+ protected:
+  bool isRunning() override;
+  void update(double deltaTime) override;
+  void fixedUpdate(double timestep) override;
+  void render(double alpha) override;
+  void present() override;
+
+ private:
+  void processInput();
+  void moveCamera(float timestep);
+  void markInput() noexcept;
+  void updateTitle();
+
+  void renderLoop();
+  void stopRenderThread();
+
+  static void frameBufferSizeCallback(
+      GLFWwindow* window,
+      int width,
+      int height);
+  static void mouseCallback(GLFWwindow* window, double xpos, double ypos);
+  static void scrollCallback(
+      GLFWwindow* window,
+      double xoffset,
+      double yoffset);
+};
+
+#endif  // INCLUDE_INCLUDE_VIEWERAPPLICATION_HPP_
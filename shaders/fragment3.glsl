@@ -0,0 +1,26 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+struct Material
+{
+  sampler2DArray texture_diffuse1;
+  sampler2DArray texture_specular1;
+};
+
+// Diffuse and specular array layers in x and y.
+layout(std140) uniform Object
+{
+  mat4 model;
+  vec4 materialLayers;
+};
+
+uniform Material material;
+
+void main()
+{
+  FragColor =
+      texture(material.texture_diffuse1, vec3(TexCoords, materialLayers.x));
+}
@@ -0,0 +1,27 @@
+#version 330 core
+
+out float Depth;
+
+uniform sampler2D source;
+uniform bool reverseDepth;
+
+// Each texel keeps the farthest of the 2x2 source texels it covers. Levels
+// round down, so the last texel of an odd-sized source also takes the
+// leftover row or column.
+void main()
+{
+  ivec2 size = textureSize(source, 0);
+  ivec2 base = ivec2(gl_FragCoord.xy) * 2;
+  ivec2 extent = ivec2(2) + ivec2(equal(base + 3, size));
+
+  float farthest = 0.0f;
+  for (int y = 0; y < extent.y; y++)
+  {
+    for (int x = 0; x < extent.x; x++)
+    {
+      float depth = texelFetch(source, base + ivec2(x, y), 0).r;
+      farthest = max(farthest, reverseDepth ? 1.0f - depth : depth);
+    }
+  }
+  Depth = farthest;
+}
@@ -0,0 +1,28 @@
+#version 330 core
+
+struct Material
+{
+  sampler2D texture_diffuse1;
+  sampler2D texture_specular1;
+};
+
+in vec3 Position;
+in vec3 Normal;
+in vec2 TexCoords;
+in float ViewDepth;
+
+out vec4 FragColor;
+
+uniform Material material;
+uniform float shininess;
+
+#include "lighting.glsl"
+
+void main()
+{
+  vec4 albedo = texture(material.texture_diffuse1, TexCoords);
+  float specular = texture(material.texture_specular1, TexCoords).r;
+
+  vec3 color = calcLighting(normalize(Normal), albedo.rgb, specular);
+  FragColor = vec4(color, albedo.a);
+}
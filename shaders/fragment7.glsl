@@ -0,0 +1,41 @@
+#version 330 core
+
+struct Material
+{
+  sampler2D texture_diffuse1;
+  sampler2D texture_specular1;
+};
+
+in vec3 Position;
+in vec3 Normal;
+in vec2 TexCoords;
+in float ViewDepth;
+
+layout(location = 0) out vec4 AlbedoSpecular;
+layout(location = 1) out vec4 NormalShininess;
+
+uniform Material material;
+uniform float shininess;
+
+// Octahedral encoding folds the lower hemisphere over the upper one so a
+// unit normal fits in two [0, 1] components.
+vec2 encodeNormal(vec3 n)
+{
+  n /= abs(n.x) + abs(n.y) + abs(n.z);
+  if (n.z < 0.0f)
+  {
+    vec2 signs = vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+    n.xy = (1.0f - abs(n.yx)) * signs;
+  }
+  return n.xy * 0.5f + 0.5f;
+}
+
+void main()
+{
+  vec3 albedo = texture(material.texture_diffuse1, TexCoords).rgb;
+  float specular = texture(material.texture_specular1, TexCoords).r;
+
+  AlbedoSpecular = vec4(albedo, specular);
+  NormalShininess =
+      vec4(encodeNormal(normalize(Normal)), shininess / 256.0f, 0.0f);
+}
@@ -0,0 +1,56 @@
+#version 330 core
+
+out vec4 FragColor;
+
+layout(std140) uniform Frame
+{
+  mat4 projection;
+  mat4 view;
+};
+
+uniform sampler2D gAlbedoSpecular;
+uniform sampler2D gNormalShininess;
+uniform sampler2D gDepth;
+uniform mat4 inverseViewProjection;
+uniform bool reverseZ;
+
+vec3 Position;
+float ViewDepth;
+float shininess;
+
+#include "lighting.glsl"
+
+vec3 decodeNormal(vec2 e)
+{
+  e = e * 2.0f - 1.0f;
+  vec3 n = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0f);
+  n.x += n.x >= 0.0f ? -t : t;
+  n.y += n.y >= 0.0f ? -t : t;
+  return normalize(n);
+}
+
+// Shades one G-buffer texel with the lighting shared with fragment6.glsl. The
+// world position is rebuilt from depth; background texels are left alone.
+// Reverse-Z clears depth to 0 and clips it to [0, 1] rather than [-1, 1].
+void main()
+{
+  ivec2 texel = ivec2(gl_FragCoord.xy);
+  float depth = texelFetch(gDepth, texel, 0).r;
+  if (depth == (reverseZ ? 0.0f : 1.0f))
+    discard;
+
+  vec2 uv = gl_FragCoord.xy / vec2(textureSize(gDepth, 0));
+  vec3 ndc = vec3(uv * 2.0f - 1.0f, reverseZ ? depth : depth * 2.0f - 1.0f);
+  vec4 position = inverseViewProjection * vec4(ndc, 1.0f);
+  Position = position.xyz / position.w;
+  ViewDepth = -(view * vec4(Position, 1.0f)).z;
+
+  vec4 albedoSpecular = texelFetch(gAlbedoSpecular, texel, 0);
+  vec4 normalShininess = texelFetch(gNormalShininess, texel, 0);
+  vec3 normal = decodeNormal(normalShininess.xy);
+  shininess = normalShininess.z * 256.0f;
+
+  vec3 color = calcLighting(normal, albedoSpecular.rgb, albedoSpecular.a);
+  FragColor = vec4(color, 1.0f);
+}
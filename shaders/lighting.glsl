@@ -0,0 +1,109 @@
+// Lighting shared by the forward (fragment6.glsl) and deferred
+// (fragment8.glsl) passes. The including shader declares Position,
+// ViewDepth and shininess before the #include.
+
+struct DirLight
+{
+  vec3 direction;
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+#define CASCADE_COUNT 4
+#define TILE_SIZE 16
+
+uniform vec3 viewPosition;
+
+uniform DirLight dirLight;
+
+uniform bool shadowsEnabled;
+uniform sampler2DShadow shadowMap;
+uniform mat4 cascadeMatrices[CASCADE_COUNT];
+uniform float cascadeSplits[CASCADE_COUNT];
+
+uniform samplerBuffer lights;
+uniform usamplerBuffer lightTiles;
+uniform int tilesX;
+
+float calcShadow(vec3 normal, vec3 lightRayDir)
+{
+  int cascade = 0;
+  while (cascade < CASCADE_COUNT && ViewDepth > cascadeSplits[cascade])
+    cascade++;
+  if (cascade == CASCADE_COUNT)
+    return 1.0f;
+
+  vec4 shadowCoord = cascadeMatrices[cascade] * vec4(Position, 1.0f);
+  float bias = 0.0005f * (1.0f - dot(normal, lightRayDir));
+
+  // Hardware 2x2 PCF per tap; the four taps stay within half a texel so
+  // they cannot reach a neighbouring cascade in the atlas.
+  vec2 texel = 0.5f / vec2(textureSize(shadowMap, 0));
+  float lit = 0.0f;
+  for (int i = 0; i < 4; i++)
+  {
+    vec2 offset = vec2((i & 1) != 0 ? texel.x : -texel.x,
+                       (i & 2) != 0 ? texel.y : -texel.y);
+    lit += texture(shadowMap,
+                   vec3(shadowCoord.xy + offset, shadowCoord.z - bias));
+  }
+  return lit * 0.25f;
+}
+
+// Lights binned into this pixel's screen tile; see LightGrid for the layout.
+vec3 calcPointLights(vec3 normal, vec3 viewDir, vec3 albedo, vec3 specular)
+{
+  ivec2 tile = ivec2(gl_FragCoord.xy) / TILE_SIZE;
+  int tileIndex = (tile.y * tilesX + tile.x) * 2;
+  int offset = int(texelFetch(lightTiles, tileIndex).r);
+  int count = int(texelFetch(lightTiles, tileIndex + 1).r);
+
+  vec3 result = vec3(0.0f);
+  for (int i = 0; i < count; i++)
+  {
+    int light = int(texelFetch(lightTiles, offset + i).r);
+    vec4 positionRadius = texelFetch(lights, light * 2);
+    vec3 color = texelFetch(lights, light * 2 + 1).rgb;
+
+    vec3 toLight = positionRadius.xyz - Position;
+    float distance = length(toLight);
+    if (distance >= positionRadius.w)
+      continue;
+
+    vec3 lightRayDir = toLight / distance;
+    vec3 reflectRayDir = reflect(-lightRayDir, normal);
+    float diff = max(dot(normal, lightRayDir), 0.0f);
+    float spec = pow(max(dot(viewDir, reflectRayDir), 0.0f), shininess);
+
+    float falloff = distance / positionRadius.w;
+    falloff = clamp(1.0f - falloff * falloff * falloff * falloff, 0.0f, 1.0f);
+    float attenuation = falloff * falloff / (distance * distance + 1.0f);
+
+    result += color * attenuation * (diff * albedo + spec * specular);
+  }
+  return result;
+}
+
+// Specular maps are read as a single intensity, which is all the G-buffer
+// keeps, so both paths shade the same surface identically.
+vec3 calcLighting(vec3 normal, vec3 albedo, float specularIntensity)
+{
+  vec3 viewDir = normalize(viewPosition - Position);
+  vec3 lightRayDir = normalize(-dirLight.direction);
+  vec3 reflectRayDir = reflect(-lightRayDir, normal);
+
+  float diff = max(dot(normal, lightRayDir), 0.0f);
+  float spec = pow(max(dot(viewDir, reflectRayDir), 0.0f), shininess);
+  float shadow = diff > 0.0f ? 1.0f : 0.0f;
+  if (shadowsEnabled && diff > 0.0f)
+    shadow = calcShadow(normal, lightRayDir);
+
+  vec3 specularColor = vec3(specularIntensity);
+  vec3 ambient = dirLight.ambient * albedo;
+  vec3 diffuse = dirLight.diffuse * diff * albedo;
+  vec3 specular = dirLight.specular * spec * specularColor;
+
+  vec3 color = ambient + shadow * (diffuse + specular);
+  return color + calcPointLights(normal, viewDir, albedo, specularColor);
+}
@@ -6,9 +6,19 @@ layout(location = 2) in vec2 aTexCoords;
 
 out vec2 TexCoords;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+  mat4 projection;
+  mat4 view;
+};
+
+layout(std140) uniform Object
+{
+  mat4 model;
+  vec4 materialLayers;
+};
+
+invariant gl_Position;
 
 void main()
 {
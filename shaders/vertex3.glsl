@@ -0,0 +1,115 @@
+#version 330 core
+
+layout(location = 0) in vec4 aSphere;
+layout(location = 1) in vec4 aCone;
+layout(location = 2) in uvec3 aDraw;
+layout(location = 3) in uint aPrevious;
+
+flat out uint count;
+flat out uint instanceCount;
+flat out uint firstIndex;
+flat out uint baseVertex;
+flat out uint baseInstance;
+
+uniform samplerBuffer objects;
+uniform int objectBase;
+uniform int objectStride;
+
+uniform mat4 viewProjection;
+uniform vec4 frustumPlanes[6];
+uniform vec3 cameraPosition;
+uniform bool coneCulling;
+
+uniform sampler2D depthPyramid;
+uniform vec2 viewportSize;
+uniform int pyramidLevels;
+uniform int phase;
+
+const float NEAR_W = 1e-4f;
+
+bool isOccluded(vec3 center, float radius)
+{
+  vec2 minUv = vec2(1.0f);
+  vec2 maxUv = vec2(0.0f);
+  float minDepth = 1.0f;
+  for (int i = 0; i < 8; i++)
+  {
+    vec3 offset = vec3((i & 1) != 0 ? 1.0f : -1.0f,
+                       (i & 2) != 0 ? 1.0f : -1.0f,
+                       (i & 4) != 0 ? 1.0f : -1.0f);
+    vec4 clip = viewProjection * vec4(center + offset * radius, 1.0f);
+    if (clip.w < NEAR_W || clip.z < -clip.w)
+      return false;
+
+    vec3 ndc = clip.xyz / clip.w;
+    minUv = min(minUv, ndc.xy * 0.5f + 0.5f);
+    maxUv = max(maxUv, ndc.xy * 0.5f + 0.5f);
+    minDepth = min(minDepth, ndc.z * 0.5f + 0.5f);
+  }
+
+  // Pyramid level 0 is half the viewport; pick the level where the bounds
+  // cover at most 2x2 texels.
+  ivec2 size = textureSize(depthPyramid, 0);
+  ivec2 minTexel = clamp(
+      ivec2(clamp(minUv, 0.0f, 1.0f) * viewportSize) / 2, ivec2(0), size - 1);
+  ivec2 maxTexel = clamp(
+      ivec2(clamp(maxUv, 0.0f, 1.0f) * viewportSize) / 2, ivec2(0), size - 1);
+  ivec2 extent = maxTexel - minTexel + 1;
+  int level = clamp(
+      int(ceil(log2(float(max(extent.x, extent.y))))), 0, pyramidLevels - 1);
+
+  ivec2 levelSize = textureSize(depthPyramid, level);
+  ivec2 low = min(minTexel >> level, levelSize - 1);
+  ivec2 high = min(maxTexel >> level, levelSize - 1);
+  float farthest = max(
+      max(texelFetch(depthPyramid, low, level).r,
+          texelFetch(depthPyramid, ivec2(high.x, low.y), level).r),
+      max(texelFetch(depthPyramid, ivec2(low.x, high.y), level).r,
+          texelFetch(depthPyramid, high, level).r));
+
+  return minDepth > farthest;
+}
+
+void main()
+{
+  int base = objectBase + int(aDraw.z) * objectStride;
+  mat4 model = mat4(texelFetch(objects, base),
+                    texelFetch(objects, base + 1),
+                    texelFetch(objects, base + 2),
+                    texelFetch(objects, base + 3));
+
+  vec3 center = vec3(model * vec4(aSphere.xyz, 1.0f));
+  float scale = max(length(model[0].xyz),
+                    max(length(model[1].xyz), length(model[2].xyz)));
+  float radius = aSphere.w * scale;
+
+  bool visible = true;
+  for (int i = 0; i < 6; i++)
+    visible = visible &&
+              dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w >= -radius;
+
+  vec3 eye = vec3(inverse(model) * vec4(cameraPosition, 1.0f));
+  vec3 toCenter = aSphere.xyz - eye;
+  visible = visible &&
+            (!coneCulling ||
+             dot(toCenter, aCone.xyz) < aCone.w * length(toCenter) + aSphere.w);
+
+  // Phase 1 redraws what was visible last frame; phase 2 tests everything
+  // against the pyramid built from phase 1, draws what phase 1 missed and
+  // records visibility for the next frame in baseInstance.
+  if (phase == 1)
+  {
+    instanceCount = (visible && aPrevious != 0u) ? 1u : 0u;
+    baseInstance = 0u;
+  }
+  else
+  {
+    visible = visible && !isOccluded(center, radius);
+    instanceCount = (visible && aPrevious == 0u) ? 1u : 0u;
+    baseInstance = visible ? 1u : 0u;
+  }
+
+  count = aDraw.x;
+  firstIndex = aDraw.y;
+  baseVertex = 0u;
+}
@@ -0,0 +1,7 @@
+#version 330 core
+
+void main()
+{
+  vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+  gl_Position = vec4(pos * 2.0f - 1.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPosition;
+
+layout(std140) uniform Frame
+{
+  mat4 projection;
+  mat4 view;
+};
+
+layout(std140) uniform Object
+{
+  mat4 model;
+};
+
+// Must match vertex2.glsl exactly so the shading pass can test GL_EQUAL.
+invariant gl_Position;
+
+void main()
+{
+  vec4 pos = view * model * vec4(aPosition, 1.0f);
+  gl_Position = projection * pos;
+}
@@ -0,0 +1,34 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoords;
+
+out vec3 Position;
+out vec3 Normal;
+out vec2 TexCoords;
+out float ViewDepth;
+
+layout(std140) uniform Frame
+{
+  mat4 projection;
+  mat4 view;
+};
+
+layout(std140) uniform Object
+{
+  mat4 model;
+};
+
+invariant gl_Position;
+
+void main()
+{
+  Position = vec3(model * vec4(aPosition, 1.0f));
+  Normal = mat3(model) * aNormal;
+  TexCoords = aTexCoords;
+
+  vec4 pos = view * model * vec4(aPosition, 1.0f);
+  ViewDepth = -pos.z;
+  gl_Position = projection * pos;
+}
@@ -0,0 +1,68 @@
+#include "Application.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "FramePacer.hpp"
+#include "FrameStats.hpp"
+#include "Profiler.hpp"
+
+void Application::run()
+{
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  auto lastFrame = Clock::now();
+  double accumulator = 0.0;
+  while (isRunning())
+  {
+    PROFILE_FRAME();
+
+    auto frameBegin = Clock::now();
+    double deltaTime = Seconds(frameBegin - lastFrame).count();
+    lastFrame = frameBegin;
+
+    update(deltaTime);
+
+    // Simulation advances in fixed steps; rendering blends the last two
+    // simulated states by the leftover fraction of a step.
+    accumulator += std::min(deltaTime, MAX_FRAME_TIME);
+    unsigned int steps = 0;
+    while (accumulator >= fixedTimestep && steps < MAX_STEPS_PER_FRAME)
+    {
+      fixedUpdate(fixedTimestep);
+      accumulator -= fixedTimestep;
+      steps++;
+    }
+    if (steps == MAX_STEPS_PER_FRAME)
+      accumulator = std::fmod(accumulator, fixedTimestep);
+
+    render(accumulator / fixedTimestep);
+    {
+      PROFILE_SCOPE("Application::present");
+      present();
+    }
+    framePacer.wait();
+
+    frameStats.add(Milliseconds(Clock::now() - frameBegin).count());
+
+    // Runs outside the measured interval, for work such as readbacks that
+    // should not count towards frame time.
+    endFrame();
+  }
+}
+
+void Application::fixedUpdate([[maybe_unused]] double timestep)
+{
+}
+
+void Application::endFrame()
+{
+}
+
+const FrameStats& Application::getFrameStats() const noexcept
+{
+  return frameStats;
+}
@@ -1,9 +1,14 @@
 #include "Camera.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Frustum.hpp"
+#include "Generation.hpp"
+#include "Projection.hpp"
 #include "glad/glad.h"
 
 Camera::Camera(
@@ -18,14 +23,50 @@ Camera::Camera(
       yaw(yaw),
       pitch(pitch),
       speed(speed),
-      sensitivity(sensitivity)
+      sensitivity(sensitivity),
+      generation(Generation::next()),
+      frustum(glm::mat4(1.0F))
 {
   _updateDirection();
 }
 
-glm::mat4 Camera::getViewMatrix() const
+// Matrices and the frustum are rebuilt lazily on the first read after a
+// change, so getters must not race with each other across threads.
+const glm::mat4& Camera::getViewMatrix() const
 {
-  return glm::lookAt(position, position + front, up);
+  _updateView();
+  return view;
+}
+
+const glm::mat4& Camera::getInverseViewMatrix() const
+{
+  _updateView();
+  return inverseView;
+}
+
+const glm::mat4& Camera::getViewProjectionMatrix(
+    const Projection& projection) const
+{
+  _updateViewProjection(projection);
+  return viewProjection;
+}
+
+const glm::mat4& Camera::getInverseViewProjectionMatrix(
+    const Projection& projection) const
+{
+  _updateViewProjection(projection);
+  return inverseViewProjection;
+}
+
+const Frustum& Camera::getFrustum(const Projection& projection) const
+{
+  _updateViewProjection(projection);
+  return frustum;
+}
+
+std::uint64_t Camera::getGeneration() const noexcept
+{
+  return generation;
 }
 
 void Camera::updatePosition(Camera::MoveDir direction, float deltaTime) noexcept
@@ -38,6 +79,7 @@ void Camera::updatePosition(Camera::MoveDir direction, float deltaTime) noexcept
     case MoveDir::LEFT: position -= right * velocity; break;
     case MoveDir::RIGHT: position += right * velocity; break;
   }
+  _markChanged();
 }
 
 void Camera::updateDirection(float xoffset, float yoffset)
@@ -53,6 +95,51 @@ void Camera::updateDirection(float xoffset, float yoffset)
   _updateDirection();
 }
 
+void Camera::setPosition(glm::vec3 position) noexcept
+{
+  if (position == this->position)
+    return;
+
+  this->position = position;
+  _markChanged();
+}
+
+void Camera::setOrientation(float yaw, float pitch)
+{
+  pitch = glm::clamp(pitch, MIN_PITCH, MAX_PITCH);
+  if (yaw == this->yaw && pitch == this->pitch)
+    return;
+
+  this->yaw = yaw;
+  this->pitch = pitch;
+
+  _updateDirection();
+}
+
+CameraState Camera::getState() const noexcept
+{
+  return { position, yaw, pitch };
+}
+
+void Camera::setState(const CameraState& state)
+{
+  setPosition(state.position);
+  setOrientation(state.yaw, state.pitch);
+}
+
+CameraState Camera::interpolate(
+    const CameraState& from,
+    const CameraState& to,
+    float alpha) noexcept
+{
+  float yawDelta = to.yaw - from.yaw;
+  yawDelta -= 360.0F * std::round(yawDelta / 360.0F);
+
+  return { glm::mix(from.position, to.position, alpha),
+           from.yaw + yawDelta * alpha,
+           glm::mix(from.pitch, to.pitch, alpha) };
+}
+
 glm::vec3 Camera::getPosition() const noexcept
 {
   return position;
@@ -88,6 +175,37 @@ void Camera::_updateDirection()
   front = glm::normalize(newFront);
   right = glm::normalize(glm::cross(front, worldUp));
   up = glm::normalize(glm::cross(right, front));
+  _markChanged();
+}
+
+void Camera::_markChanged() noexcept
+{
+  generation = Generation::next();
+}
+
+void Camera::_updateView() const
+{
+  if (viewGeneration == generation)
+    return;
+
+  view = glm::lookAt(position, position + front, up);
+  inverseView = glm::inverse(view);
+  viewGeneration = generation;
+}
+
+void Camera::_updateViewProjection(const Projection& projection) const
+{
+  if (viewProjectionGeneration == generation &&
+      projectionGeneration == projection.getGeneration())
+  {
+    return;
+  }
+
+  viewProjection = projection.getProjectionMatrix() * getViewMatrix();
+  inverseViewProjection = glm::inverse(viewProjection);
+  frustum = Frustum(viewProjection);
+  viewProjectionGeneration = generation;
+  projectionGeneration = projection.getGeneration();
 }
 
 CameraBuilder& CameraBuilder::setPosition(glm::vec3 position) noexcept
@@ -0,0 +1,54 @@
+#include "CameraPath.hpp"
+
+#include <cmath>
+#include <glm/glm.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "Camera.hpp"
+
+CameraPath::CameraPath(std::vector<CameraKeyframe>&& keyframes)
+    : keyframes(std::move(keyframes))
+{
+  if (this->keyframes.empty())
+  {
+    throw std::runtime_error("Invalid Argument: Empty Camera Path");
+  }
+}
+
+void CameraPath::apply(Camera& camera, float t) const
+{
+  float position = (t - std::floor(t)) * keyframes.size();
+  std::size_t first = static_cast<std::size_t>(position) % keyframes.size();
+  std::size_t second = (first + 1) % keyframes.size();
+  float alpha = position - std::floor(position);
+
+  camera.setState(
+      Camera::interpolate(keyframes[first], keyframes[second], alpha));
+}
+
+CameraPath CameraPath::orbit(
+    glm::vec3 center,
+    float radius,
+    float height,
+    int steps)
+{
+  std::vector<CameraKeyframe> keyframes;
+  for (int i = 0; i < steps; i++)
+  {
+    float angle = glm::radians(360.0F * i / steps);
+    glm::vec3 position =
+        center + glm::vec3(
+                     radius * std::cos(angle),
+                     height,
+                     radius * std::sin(angle));
+
+    glm::vec3 toCenter = center - position;
+    float yaw = glm::degrees(std::atan2(toCenter.z, toCenter.x));
+    float pitch = glm::degrees(
+        std::atan2(toCenter.y, glm::length(glm::vec2(toCenter.x, toCenter.z))));
+
+    keyframes.push_back({ position, yaw, pitch });
+  }
+  return CameraPath(std::move(keyframes));
+}
@@ -0,0 +1,211 @@
+#include "CascadedShadowMap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <stdexcept>
+
+#include "Frustum.hpp"
+#include "Profiler.hpp"
+#include "glad/glad.h"
+
+CascadedShadowMap::CascadedShadowMap(int tileSize)
+    : tileSize(tileSize),
+      cascades {}
+{
+  if (tileSize <= 0)
+    throw std::runtime_error("ERROR::SHADOW_MAP::INVALID_SIZE");
+
+  int atlasSize = tileSize * ATLAS_TILES;
+
+  glGenTextures(1, &depthTexture);
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      GL_DEPTH_COMPONENT24,
+      atlasSize,
+      atlasSize,
+      0,
+      GL_DEPTH_COMPONENT,
+      GL_UNSIGNED_INT,
+      nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(
+      GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+
+  bool complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (!complete)
+  {
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &depthTexture);
+    throw std::runtime_error("ERROR::SHADOW_MAP::INCOMPLETE");
+  }
+
+  for (std::size_t i = 0; i < CASCADE_COUNT; i++)
+  {
+    cascades[i].x = static_cast<int>(i) % ATLAS_TILES * tileSize;
+    cascades[i].y = static_cast<int>(i) / ATLAS_TILES * tileSize;
+  }
+}
+
+CascadedShadowMap::~CascadedShadowMap() noexcept
+{
+  glDeleteFramebuffers(1, &fbo);
+  glDeleteTextures(1, &depthTexture);
+}
+
+// Splits blend logarithmic and uniform distributions over the projection's
+// near/far range (the "practical" scheme), read back from the matrix so the
+// renderer can keep taking plain matrices. Each slice is fitted with a
+// bounding sphere, which does not change size as the camera turns, and its
+// centre is snapped to whole shadow texels in a fixed light-space rotation;
+// together these keep shadow edges from shimmering.
+void CascadedShadowMap::update(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    glm::vec3 lightDirection)
+{
+  PROFILE_FUNCTION();
+  float near = projection[3][2] / (projection[2][2] - 1.0F);
+  float far = projection[3][2] / (projection[2][2] + 1.0F);
+
+  glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+  std::array<glm::vec3, 4> nearCorners, farCorners;
+  for (std::size_t i = 0; i < 4; i++)
+  {
+    float x = (i & 1) != 0 ? 1.0F : -1.0F;
+    float y = (i & 2) != 0 ? 1.0F : -1.0F;
+
+    glm::vec4 nearCorner = inverseViewProjection * glm::vec4(x, y, -1.0F, 1.0F);
+    glm::vec4 farCorner = inverseViewProjection * glm::vec4(x, y, 1.0F, 1.0F);
+    nearCorners[i] = glm::vec3(nearCorner) / nearCorner.w;
+    farCorners[i] = glm::vec3(farCorner) / farCorner.w;
+  }
+
+  glm::vec3 direction = glm::normalize(lightDirection);
+  glm::vec3 up = std::abs(direction.y) > 0.99F ? glm::vec3(0.0F, 0.0F, 1.0F)
+                                                : glm::vec3(0.0F, 1.0F, 0.0F);
+  glm::mat4 lightView = glm::lookAt(glm::vec3(0.0F), direction, up);
+
+  float splitNear = near;
+  for (std::size_t i = 0; i < CASCADE_COUNT; i++)
+  {
+    float fraction = static_cast<float>(i + 1) / CASCADE_COUNT;
+    float logSplit = near * std::pow(far / near, fraction);
+    float uniformSplit = near + (far - near) * fraction;
+    float splitFar =
+        SPLIT_LAMBDA * logSplit + (1.0F - SPLIT_LAMBDA) * uniformSplit;
+
+    float nearT = (splitNear - near) / (far - near);
+    float farT = (splitFar - near) / (far - near);
+
+    std::array<glm::vec3, 8> corners;
+    glm::vec3 center(0.0F);
+    for (std::size_t k = 0; k < 4; k++)
+    {
+      glm::vec3 edge = farCorners[k] - nearCorners[k];
+      corners[k] = nearCorners[k] + edge * nearT;
+      corners[k + 4] = nearCorners[k] + edge * farT;
+      center = center + corners[k] + corners[k + 4];
+    }
+    center = center / 8.0F;
+
+    float radius = 0.0F;
+    for (const auto& corner : corners)
+      radius = std::max(radius, glm::distance(center, corner));
+    radius = std::ceil(radius * 16.0F) / 16.0F;
+
+    glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0F));
+    float texel = 2.0F * radius / static_cast<float>(tileSize);
+    lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+    lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+
+    glm::mat4 lightProjection = glm::ortho(
+        lightCenter.x - radius,
+        lightCenter.x + radius,
+        lightCenter.y - radius,
+        lightCenter.y + radius,
+        -(lightCenter.z + radius + CASTER_DISTANCE),
+        -(lightCenter.z - radius));
+
+    ShadowCascade& cascade = cascades[i];
+    cascade.viewProjection = lightProjection * lightView;
+    cascade.splitFar = splitFar;
+
+    // Maps clip space to this cascade's tile of the atlas.
+    float tileScale = 0.5F / ATLAS_TILES;
+    int atlasSize = tileSize * ATLAS_TILES;
+    glm::mat4 tileMatrix(1.0F);
+    tileMatrix[0][0] = tileScale;
+    tileMatrix[1][1] = tileScale;
+    tileMatrix[2][2] = 0.5F;
+    tileMatrix[3] = glm::vec4(
+        tileScale + static_cast<float>(cascade.x) / atlasSize,
+        tileScale + static_cast<float>(cascade.y) / atlasSize,
+        0.5F,
+        1.0F);
+    cascade.shadowMatrix = tileMatrix * cascade.viewProjection;
+
+    splitNear = splitFar;
+  }
+}
+
+void CascadedShadowMap::begin() const noexcept
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glViewport(0, 0, tileSize * ATLAS_TILES, tileSize * ATLAS_TILES);
+  glClear(GL_DEPTH_BUFFER_BIT);
+
+  glEnable(GL_POLYGON_OFFSET_FILL);
+  glPolygonOffset(2.0F, 4.0F);
+}
+
+void CascadedShadowMap::beginCascade(std::size_t cascade) const noexcept
+{
+  glViewport(cascades[cascade].x, cascades[cascade].y, tileSize, tileSize);
+}
+
+// The caller rebinds its own framebuffer and viewport.
+void CascadedShadowMap::end() const noexcept
+{
+  glDisable(GL_POLYGON_OFFSET_FILL);
+}
+
+const ShadowCascade& CascadedShadowMap::getCascade(
+    std::size_t cascade) const noexcept
+{
+  return cascades[cascade];
+}
+
+Frustum CascadedShadowMap::getCascadeFrustum(std::size_t cascade) const
+{
+  return Frustum(cascades[cascade].viewProjection);
+}
+
+unsigned int CascadedShadowMap::getTexture() const noexcept
+{
+  return depthTexture;
+}
+
+int CascadedShadowMap::getTileSize() const noexcept
+{
+  return tileSize;
+}
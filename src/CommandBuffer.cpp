@@ -0,0 +1,326 @@
+#include "CommandBuffer.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <type_traits>
+
+#include "GLExtensions.hpp"
+#include "Profiler.hpp"
+#include "glad/glad.h"
+
+void CommandBuffer::clear() noexcept
+{
+  bytes.clear();
+  commandCount = 0;
+
+  currentProgram = 0;
+  currentVertexArray = 0;
+  currentTextures.fill(0);
+}
+
+bool CommandBuffer::empty() const noexcept
+{
+  return commandCount == 0;
+}
+
+std::size_t CommandBuffer::size() const noexcept
+{
+  return bytes.size();
+}
+
+std::size_t CommandBuffer::getCommandCount() const noexcept
+{
+  return commandCount;
+}
+
+void CommandBuffer::useProgram(unsigned int program)
+{
+  if (program == currentProgram)
+    return;
+
+  currentProgram = program;
+  write(Op::USE_PROGRAM);
+  write(program);
+}
+
+void CommandBuffer::bindVertexArray(unsigned int vao, unsigned int positionVao)
+{
+  if (vao == currentVertexArray)
+    return;
+
+  currentVertexArray = vao;
+  write(Op::BIND_VERTEX_ARRAY);
+  write(vao);
+  write(positionVao);
+}
+
+void CommandBuffer::bindTexture(
+    unsigned int unit,
+    unsigned int target,
+    unsigned int id)
+{
+  if (unit < MAX_UNITS)
+  {
+    if (currentTextures[unit] == id)
+      return;
+    currentTextures[unit] = id;
+  }
+
+  write(Op::BIND_TEXTURE);
+  write(unit);
+  write(target);
+  write(id);
+}
+
+void CommandBuffer::bindUniformRange(
+    unsigned int binding,
+    unsigned int buffer,
+    std::size_t offset,
+    std::size_t size)
+{
+  write(Op::BIND_UNIFORM_RANGE);
+  write(binding);
+  write(buffer);
+  write(offset);
+  write(size);
+}
+
+void CommandBuffer::setUniform(int location, int value)
+{
+  if (location < 0)
+    return;
+
+  write(Op::UNIFORM_INT);
+  write(location);
+  write(value);
+}
+
+void CommandBuffer::setUniform(int location, float value)
+{
+  if (location < 0)
+    return;
+
+  write(Op::UNIFORM_FLOAT);
+  write(location);
+  write(value);
+}
+
+void CommandBuffer::setUniform(int location, const glm::mat4& value)
+{
+  if (location < 0)
+    return;
+
+  write(Op::UNIFORM_MAT4);
+  write(location);
+  write(value);
+}
+
+void CommandBuffer::drawElements(unsigned int count, std::size_t firstIndex)
+{
+  write(Op::DRAW_ELEMENTS);
+  write(count);
+  write(firstIndex);
+}
+
+void CommandBuffer::multiDrawElements(std::size_t rangeSlot)
+{
+  write(Op::MULTI_DRAW_ELEMENTS);
+  write(rangeSlot);
+}
+
+void CommandBuffer::multiDrawElementsIndirect(
+    std::size_t firstCommand,
+    unsigned int count)
+{
+  write(Op::MULTI_DRAW_ELEMENTS_INDIRECT);
+  write(firstCommand);
+  write(count);
+}
+
+// Buffers recorded separately, e.g. on different jobs, are concatenated.
+// Each starts with no known state, so its first binds replay in full.
+void CommandBuffer::append(const CommandBuffer& other)
+{
+  bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+  commandCount += other.commandCount;
+
+  if (other.currentProgram != 0)
+    currentProgram = other.currentProgram;
+  if (other.currentVertexArray != 0)
+    currentVertexArray = other.currentVertexArray;
+  for (unsigned int unit = 0; unit < MAX_UNITS; unit++)
+  {
+    if (other.currentTextures[unit] != 0)
+      currentTextures[unit] = other.currentTextures[unit];
+  }
+}
+
+void CommandBuffer::execute(
+    std::size_t uniformBase,
+    const std::vector<IndexRanges>* ranges) const
+{
+  PROFILE_SCOPE("CommandBuffer::execute");
+  replay(uniformBase, ranges, false);
+}
+
+// Replays only vertex array, uniform range and draw commands; the caller
+// binds the program. Used for depth-only passes over the same draws, which
+// switch to the position-only vertex array where one was recorded.
+void CommandBuffer::executeGeometry(
+    std::size_t uniformBase,
+    const std::vector<IndexRanges>* ranges) const
+{
+  PROFILE_SCOPE("CommandBuffer::executeGeometry");
+  replay(uniformBase, ranges, true);
+}
+
+// Uniform range offsets are recorded relative to uniformBase, so per-frame
+// data can move around a ring buffer without re-recording. Multi-draws name
+// a slot in ranges, which the caller may refill every frame. Indirect draws
+// read whatever buffer is bound to GL_DRAW_INDIRECT_BUFFER.
+void CommandBuffer::replay(
+    std::size_t uniformBase,
+    const std::vector<IndexRanges>* ranges,
+    bool geometryOnly) const
+{
+  std::size_t offset = 0;
+  while (offset < bytes.size())
+  {
+    switch (read<Op>(offset))
+    {
+      case Op::USE_PROGRAM:
+      {
+        auto program = read<unsigned int>(offset);
+        if (!geometryOnly)
+          glUseProgram(program);
+        break;
+      }
+      case Op::BIND_VERTEX_ARRAY:
+      {
+        auto vao = read<unsigned int>(offset);
+        auto positionVao = read<unsigned int>(offset);
+        glBindVertexArray(
+            geometryOnly && positionVao != 0 ? positionVao : vao);
+        break;
+      }
+      case Op::BIND_TEXTURE:
+      {
+        auto unit = read<unsigned int>(offset);
+        auto target = read<unsigned int>(offset);
+        auto id = read<unsigned int>(offset);
+        if (geometryOnly)
+          break;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, id);
+        break;
+      }
+      case Op::BIND_UNIFORM_RANGE:
+      {
+        auto binding = read<unsigned int>(offset);
+        auto buffer = read<unsigned int>(offset);
+        auto rangeOffset = read<std::size_t>(offset);
+        auto rangeSize = read<std::size_t>(offset);
+        glBindBufferRange(
+            GL_UNIFORM_BUFFER,
+            binding,
+            buffer,
+            uniformBase + rangeOffset,
+            rangeSize);
+        break;
+      }
+      case Op::UNIFORM_INT:
+      {
+        auto location = read<int>(offset);
+        auto value = read<int>(offset);
+        if (!geometryOnly)
+          glUniform1i(location, value);
+        break;
+      }
+      case Op::UNIFORM_FLOAT:
+      {
+        auto location = read<int>(offset);
+        auto value = read<float>(offset);
+        if (!geometryOnly)
+          glUniform1f(location, value);
+        break;
+      }
+      case Op::UNIFORM_MAT4:
+      {
+        auto location = read<int>(offset);
+        auto value = read<glm::mat4>(offset);
+        if (!geometryOnly)
+          glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        break;
+      }
+      case Op::DRAW_ELEMENTS:
+      {
+        auto count = read<unsigned int>(offset);
+        auto firstIndex = read<std::size_t>(offset);
+        glDrawElements(
+            GL_TRIANGLES,
+            count,
+            GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(firstIndex * sizeof(unsigned int)));
+        break;
+      }
+      case Op::MULTI_DRAW_ELEMENTS:
+      {
+        auto slot = read<std::size_t>(offset);
+        if (ranges == nullptr || slot >= ranges->size())
+          break;
+
+        const IndexRanges& range = (*ranges)[slot];
+        if (range.counts.empty())
+          break;
+
+        glMultiDrawElements(
+            GL_TRIANGLES,
+            range.counts.data(),
+            GL_UNSIGNED_INT,
+            range.offsets.data(),
+            static_cast<GLsizei>(range.counts.size()));
+        break;
+      }
+      case Op::MULTI_DRAW_ELEMENTS_INDIRECT:
+      {
+        auto firstCommand = read<std::size_t>(offset);
+        auto count = read<unsigned int>(offset);
+        GLExtensions::glMultiDrawElementsIndirect(
+            GL_TRIANGLES,
+            GL_UNSIGNED_INT,
+            reinterpret_cast<void*>(
+                firstCommand * sizeof(DrawIndirectCommand)),
+            static_cast<GLsizei>(count),
+            0);
+        break;
+      }
+    }
+  }
+
+  glBindVertexArray(0);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+template <typename T>
+void CommandBuffer::write(const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  if constexpr (std::is_same_v<T, Op>)
+    commandCount++;
+
+  std::size_t offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T CommandBuffer::read(std::size_t& offset) const noexcept
+{
+  T value;
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
@@ -0,0 +1,208 @@
+#include "DepthPyramid.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Profiler.hpp"
+#include "Shader.hpp"
+#include "glad/glad.h"
+
+namespace
+{
+// Level 0 is half the source resolution and sizes follow the usual mip
+// chain, so the texture stays mipmap complete.
+int levelSize(int size, int level)
+{
+  return std::max(1, (size / 2) >> level);
+}
+}  // namespace
+
+DepthPyramid::DepthPyramid(
+    const std::string& shaderDirectory,
+    int width,
+    int height,
+    bool reverseZ)
+    : downsampleShader(
+          shaderDirectory + "/vertex4.glsl",
+          shaderDirectory + "/fragment4.glsl"),
+      width(width),
+      height(height),
+      reverseZ(reverseZ)
+{
+  glGenVertexArrays(1, &vao);
+  create();
+}
+
+DepthPyramid::~DepthPyramid() noexcept
+{
+  destroy();
+  glDeleteVertexArrays(1, &vao);
+}
+
+void DepthPyramid::resize(int width, int height)
+{
+  if (width == this->width && height == this->height)
+    return;
+
+  destroy();
+  this->width = width;
+  this->height = height;
+  create();
+}
+
+// Copies the depth attachment of sourceFramebuffer, which must be
+// DEPTH24_STENCIL8 like the default framebuffer and Framebuffer, or
+// DEPTH32F_STENCIL8 for reverse-Z, then reduces it to a max-depth mip chain
+// starting at half resolution. Reverse-Z depth is flipped to 1 - depth in
+// the first level, which for an infinite projection is exactly the depth
+// of the matching forward-Z projection, so the pyramid is always forward.
+void DepthPyramid::build(unsigned int sourceFramebuffer)
+{
+  PROFILE_FUNCTION();
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFramebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthFbo);
+  glBlitFramebuffer(
+      0,
+      0,
+      width,
+      height,
+      0,
+      0,
+      width,
+      height,
+      GL_DEPTH_BUFFER_BIT,
+      GL_NEAREST);
+
+  glDisable(GL_DEPTH_TEST);
+  glDepthMask(GL_FALSE);
+  downsampleShader.bind();
+  downsampleShader.setInt("source", 0);
+  glBindVertexArray(vao);
+  glActiveTexture(GL_TEXTURE0);
+
+  for (int level = 0; level < getLevelCount(); level++)
+  {
+    downsampleShader.setBool("reverseDepth", reverseZ && level == 0);
+    if (level == 0)
+    {
+      glBindTexture(GL_TEXTURE_2D, depthTexture);
+    }
+    else
+    {
+      glBindTexture(GL_TEXTURE_2D, pyramidTexture);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, levelFbos[level]);
+    glViewport(0, 0, levelSize(width, level), levelSize(height, level));
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+  }
+
+  glBindTexture(GL_TEXTURE_2D, pyramidTexture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, getLevelCount() - 1);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindVertexArray(0);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, sourceFramebuffer);
+  glViewport(0, 0, width, height);
+  glDepthMask(GL_TRUE);
+  glEnable(GL_DEPTH_TEST);
+}
+
+unsigned int DepthPyramid::getTexture() const noexcept
+{
+  return pyramidTexture;
+}
+
+int DepthPyramid::getLevelCount() const noexcept
+{
+  return static_cast<int>(levelFbos.size());
+}
+
+void DepthPyramid::create()
+{
+  glGenTextures(1, &depthTexture);
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      reverseZ ? GL_DEPTH32F_STENCIL8 : GL_DEPTH24_STENCIL8,
+      width,
+      height,
+      0,
+      GL_DEPTH_STENCIL,
+      reverseZ ? GL_FLOAT_32_UNSIGNED_INT_24_8_REV : GL_UNSIGNED_INT_24_8,
+      nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+  glGenFramebuffers(1, &depthFbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, depthFbo);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER,
+      GL_DEPTH_STENCIL_ATTACHMENT,
+      GL_TEXTURE_2D,
+      depthTexture,
+      0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+
+  int levels = 1;
+  while (levelSize(width, levels - 1) > 1 || levelSize(height, levels - 1) > 1)
+    levels++;
+
+  glGenTextures(1, &pyramidTexture);
+  glBindTexture(GL_TEXTURE_2D, pyramidTexture);
+  for (int level = 0; level < levels; level++)
+  {
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        level,
+        GL_R32F,
+        levelSize(width, level),
+        levelSize(height, level),
+        0,
+        GL_RED,
+        GL_FLOAT,
+        nullptr);
+  }
+  glTexParameteri(
+      GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  levelFbos.resize(static_cast<std::size_t>(levels));
+  glGenFramebuffers(levels, levelFbos.data());
+  for (int level = 0; level < levels; level++)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, levelFbos[level]);
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        pyramidTexture,
+        level);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      destroy();
+      throw std::runtime_error("ERROR::DEPTH_PYRAMID::INCOMPLETE");
+    }
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void DepthPyramid::destroy() noexcept
+{
+  glDeleteFramebuffers(static_cast<int>(levelFbos.size()), levelFbos.data());
+  levelFbos.clear();
+  glDeleteTextures(1, &pyramidTexture);
+  glDeleteFramebuffers(1, &depthFbo);
+  glDeleteTextures(1, &depthTexture);
+}
@@ -0,0 +1,102 @@
+#include "EglContext.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "GLExtensions.hpp"
+#include "glad/glad.h"
+
+EglContext::EglContext(int major, int minor)
+{
+  using namespace std::string_literals;
+
+  auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+      eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+  display = EGL_NO_DISPLAY;
+  if (getPlatformDisplay != nullptr)
+  {
+    display = getPlatformDisplay(
+        EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  }
+  if (display == EGL_NO_DISPLAY)
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+  if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+  {
+    throw std::runtime_error("ERROR::EGL::DISPLAY_INIT_FAILED");
+  }
+
+  if (!eglBindAPI(EGL_OPENGL_API))
+  {
+    eglTerminate(display);
+    throw std::runtime_error("ERROR::EGL::BIND_API_FAILED");
+  }
+
+  const EGLint configAttribs[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE
+  };
+
+  EGLConfig config;
+  EGLint numConfigs = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) ||
+      numConfigs == 0)
+  {
+    eglTerminate(display);
+    throw std::runtime_error("ERROR::EGL::NO_CONFIG");
+  }
+
+  const EGLint contextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION,
+    major,
+    EGL_CONTEXT_MINOR_VERSION,
+    minor,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK,
+    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+  };
+
+  context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (context == EGL_NO_CONTEXT)
+  {
+    eglTerminate(display);
+    throw std::runtime_error(
+        "ERROR::EGL::CONTEXT_CREATION_FAILED: "s + std::to_string(major) +
+        "." + std::to_string(minor));
+  }
+
+  makeCurrent();
+
+  if (!gladLoadGLLoader(getProcAddress))
+  {
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    throw std::runtime_error("Failed to initialize GLAD");
+  }
+  GLExtensions::load(getProcAddress);
+}
+
+EglContext::~EglContext() noexcept
+{
+  eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  eglDestroyContext(display, context);
+  eglTerminate(display);
+}
+
+void EglContext::makeCurrent() const
+{
+  if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+  {
+    throw std::runtime_error("ERROR::EGL::MAKE_CURRENT_FAILED");
+  }
+}
+
+void* EglContext::getProcAddress(const char* name)
+{
+  return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
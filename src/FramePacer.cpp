@@ -0,0 +1,82 @@
+#include "FramePacer.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "Profiler.hpp"
+
+FramePacer::FramePacer(double targetFps) noexcept
+{
+  setTargetFps(targetFps);
+}
+
+void FramePacer::setTargetFps(double targetFps) noexcept
+{
+  pacing = false;
+  interval = targetFps > 0.0
+                 ? std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(1.0 / targetFps))
+                 : Clock::duration::zero();
+}
+
+double FramePacer::getTargetFps() const noexcept
+{
+  if (!isEnabled())
+    return 0.0;
+  return 1.0 / std::chrono::duration<double>(interval).count();
+}
+
+bool FramePacer::isEnabled() const noexcept
+{
+  return interval > Clock::duration::zero();
+}
+
+void FramePacer::wait()
+{
+  if (!isEnabled())
+    return;
+
+  PROFILE_SCOPE("FramePacer::wait");
+  auto now = Clock::now();
+
+  deadline = pacing ? deadline + interval : now + interval;
+  pacing = true;
+
+  // A missed deadline re-anchors the schedule instead of letting the next
+  // frames run back to back to catch up.
+  if (now >= deadline)
+  {
+    deadline = now;
+    return;
+  }
+
+  // The OS sleep granularity is coarse, so sleep until just before the
+  // deadline and spin the remainder.
+  if (deadline - now > SPIN_THRESHOLD)
+    std::this_thread::sleep_for(deadline - now - SPIN_THRESHOLD);
+
+  while (Clock::now() < deadline)
+    std::this_thread::yield();
+}
+
+int FramePacer::swapInterval(SwapMode mode) noexcept
+{
+  switch (mode)
+  {
+    case SwapMode::IMMEDIATE: return 0;
+    case SwapMode::VSYNC: return 1;
+    case SwapMode::ADAPTIVE: return -1;
+  }
+  return 1;
+}
+
+const char* FramePacer::swapModeStr(SwapMode mode) noexcept
+{
+  switch (mode)
+  {
+    case SwapMode::IMMEDIATE: return "immediate";
+    case SwapMode::VSYNC: return "vsync";
+    case SwapMode::ADAPTIVE: return "adaptive";
+  }
+  return "";
+}
@@ -0,0 +1,58 @@
+#include "FrameSnapshotBuffer.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include "Profiler.hpp"
+
+FrameSnapshot* FrameSnapshotBuffer::beginWrite()
+{
+  PROFILE_SCOPE("FrameSnapshotBuffer::beginWrite");
+  std::unique_lock lock(mutex);
+
+  // The write slot is the one the consumer acquired before the latest
+  // publish, so it is only free once the consumer has taken that one.
+  consumed.wait(lock, [this] { return !pending || closed; });
+  if (closed)
+    return nullptr;
+
+  return &snapshots[writeIndex];
+}
+
+void FrameSnapshotBuffer::publish()
+{
+  {
+    std::lock_guard lock(mutex);
+    std::swap(writeIndex, readIndex);
+    pending = true;
+  }
+  published.notify_one();
+}
+
+const FrameSnapshot* FrameSnapshotBuffer::acquire()
+{
+  PROFILE_SCOPE("FrameSnapshotBuffer::acquire");
+  const FrameSnapshot* snapshot = nullptr;
+  {
+    std::unique_lock lock(mutex);
+    published.wait(lock, [this] { return pending || closed; });
+    if (closed)
+      return nullptr;
+
+    pending = false;
+    snapshot = &snapshots[readIndex];
+  }
+  consumed.notify_one();
+
+  return snapshot;
+}
+
+void FrameSnapshotBuffer::close()
+{
+  {
+    std::lock_guard lock(mutex);
+    closed = true;
+  }
+  published.notify_all();
+  consumed.notify_all();
+}
@@ -0,0 +1,51 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+void FrameStats::add(double milliseconds)
+{
+  samples.push_back(milliseconds);
+}
+
+void FrameStats::clear() noexcept
+{
+  samples.clear();
+}
+
+std::size_t FrameStats::count() const noexcept
+{
+  return samples.size();
+}
+
+double FrameStats::mean() const noexcept
+{
+  if (samples.empty())
+    return 0.0;
+  return std::accumulate(samples.begin(), samples.end(), 0.0) /
+         samples.size();
+}
+
+double FrameStats::max() const noexcept
+{
+  if (samples.empty())
+    return 0.0;
+  return *std::max_element(samples.begin(), samples.end());
+}
+
+double FrameStats::percentile(double p) const
+{
+  if (samples.empty())
+    return 0.0;
+
+  std::vector<double> sorted(samples);
+  auto rank = static_cast<std::size_t>(
+      std::ceil(std::clamp(p, 0.0, 1.0) * sorted.size()));
+  auto nth = sorted.begin() + (rank == 0 ? 0 : rank - 1);
+
+  std::nth_element(sorted.begin(), nth, sorted.end());
+  return *nth;
+}
@@ -0,0 +1,136 @@
+#include "Framebuffer.hpp"
+
+#include <stdexcept>
+
+#include "Image.hpp"
+#include "glad/glad.h"
+
+Framebuffer::Framebuffer(int width, int height, bool floatDepth)
+    : width(width),
+      height(height)
+{
+  glGenFramebuffers(1, &fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+  glGenTextures(1, &colorTexture);
+  glBindTexture(GL_TEXTURE_2D, colorTexture);
+  glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      GL_RGBA8,
+      width,
+      height,
+      0,
+      GL_RGBA,
+      GL_UNSIGNED_BYTE,
+      nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+
+  glGenRenderbuffers(1, &depthRbo);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthRbo);
+  glRenderbufferStorage(
+      GL_RENDERBUFFER,
+      floatDepth ? GL_DEPTH32F_STENCIL8 : GL_DEPTH24_STENCIL8,
+      width,
+      height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  glFramebufferRenderbuffer(
+      GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRbo);
+
+  GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  if (status != GL_FRAMEBUFFER_COMPLETE)
+  {
+    glDeleteRenderbuffers(1, &depthRbo);
+    glDeleteTextures(1, &colorTexture);
+    glDeleteFramebuffers(1, &fbo);
+    throw std::runtime_error("ERROR::FRAMEBUFFER::INCOMPLETE");
+  }
+}
+
+Framebuffer::~Framebuffer() noexcept
+{
+  glDeleteRenderbuffers(1, &depthRbo);
+  glDeleteTextures(1, &colorTexture);
+  glDeleteFramebuffers(1, &fbo);
+}
+
+Framebuffer::Framebuffer(Framebuffer&& other)
+    : fbo(other.fbo),
+      colorTexture(other.colorTexture),
+      depthRbo(other.depthRbo),
+      width(other.width),
+      height(other.height)
+{
+  other.fbo = 0;
+  other.colorTexture = 0;
+  other.depthRbo = 0;
+}
+
+Framebuffer& Framebuffer::operator=(Framebuffer&& other)
+{
+  if (this != &other)
+  {
+    glDeleteRenderbuffers(1, &depthRbo);
+    glDeleteTextures(1, &colorTexture);
+    glDeleteFramebuffers(1, &fbo);
+
+    fbo = other.fbo;
+    colorTexture = other.colorTexture;
+    depthRbo = other.depthRbo;
+    width = other.width;
+    height = other.height;
+
+    other.fbo = 0;
+    other.colorTexture = 0;
+    other.depthRbo = 0;
+  }
+  return *this;
+}
+
+void Framebuffer::bind() const noexcept
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glViewport(0, 0, width, height);
+}
+
+void Framebuffer::unbind() const noexcept
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+Image Framebuffer::readPixels() const
+{
+  Image image(width, height, 4);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+  return image;
+}
+
+GLuint Framebuffer::getId() const noexcept
+{
+  return fbo;
+}
+
+GLuint Framebuffer::getColorTexture() const noexcept
+{
+  return colorTexture;
+}
+
+int Framebuffer::getWidth() const noexcept
+{
+  return width;
+}
+
+int Framebuffer::getHeight() const noexcept
+{
+  return height;
+}
@@ -0,0 +1,43 @@
+#include "Frustum.hpp"
+
+#include <array>
+#include <glm/glm.hpp>
+
+// Planes are the sums and differences of the matrix rows (Gribb/Hartmann),
+// so a model-view-projection matrix yields planes in model space. An
+// infinite far plane has no normal and is replaced by one nothing fails.
+Frustum::Frustum(const glm::mat4& viewProjection) noexcept
+{
+  auto row = [&](int i)
+  {
+    return glm::vec4(
+        viewProjection[0][i],
+        viewProjection[1][i],
+        viewProjection[2][i],
+        viewProjection[3][i]);
+  };
+
+  planes = { row(3) + row(0), row(3) - row(0), row(3) + row(1),
+             row(3) - row(1), row(3) + row(2), row(3) - row(2) };
+
+  for (auto& plane : planes)
+  {
+    float length = glm::length(glm::vec3(plane));
+    plane = length > 0.0F ? plane / length : glm::vec4(0.0F, 0.0F, 0.0F, 1.0F);
+  }
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const noexcept
+{
+  for (const auto& plane : planes)
+  {
+    if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+      return false;
+  }
+  return true;
+}
+
+const std::array<glm::vec4, 6>& Frustum::getPlanes() const noexcept
+{
+  return planes;
+}
@@ -0,0 +1,115 @@
+#include "GBuffer.hpp"
+
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+GBuffer::GBuffer(int width, int height, bool floatDepth)
+    : width(width),
+      height(height),
+      floatDepth(floatDepth)
+{
+  glGenVertexArrays(1, &vao);
+  create();
+}
+
+GBuffer::~GBuffer() noexcept
+{
+  destroy();
+  glDeleteVertexArrays(1, &vao);
+}
+
+void GBuffer::resize(int width, int height)
+{
+  if (width == this->width && height == this->height)
+    return;
+
+  destroy();
+  this->width = width;
+  this->height = height;
+  create();
+}
+
+void GBuffer::bind() const noexcept
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+// Binds albedo, normal and depth to consecutive units from firstUnit and
+// draws a fullscreen triangle with the current program into the current
+// framebuffer.
+void GBuffer::drawLighting(unsigned int firstUnit) const noexcept
+{
+  unsigned int textures[] = { albedoTexture, normalTexture, depthTexture };
+  for (unsigned int i = 0; i < 3; i++)
+  {
+    glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+    glBindTexture(GL_TEXTURE_2D, textures[i]);
+  }
+  glActiveTexture(GL_TEXTURE0);
+
+  glDisable(GL_DEPTH_TEST);
+  glBindVertexArray(vao);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+  glBindVertexArray(0);
+  glEnable(GL_DEPTH_TEST);
+}
+
+// Albedo is RGBA8 with specular intensity in alpha. Normals are octahedral
+// encoded in RGB10_A2 with shininess in blue. Depth matches the target's
+// format, DEPTH32F_STENCIL8 for reverse-Z, so the depth pyramid can blit it.
+void GBuffer::create()
+{
+  auto createTexture =
+      [this](unsigned int& texture, GLint format, GLenum layout, GLenum type)
+  {
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(
+        GL_TEXTURE_2D, 0, format, width, height, 0, layout, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  };
+  createTexture(albedoTexture, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+  createTexture(
+      normalTexture, GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV);
+  createTexture(
+      depthTexture,
+      floatDepth ? GL_DEPTH32F_STENCIL8 : GL_DEPTH24_STENCIL8,
+      GL_DEPTH_STENCIL,
+      floatDepth ? GL_FLOAT_32_UNSIGNED_INT_24_8_REV : GL_UNSIGNED_INT_24_8);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoTexture, 0);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalTexture, 0);
+  glFramebufferTexture2D(
+      GL_FRAMEBUFFER,
+      GL_DEPTH_STENCIL_ATTACHMENT,
+      GL_TEXTURE_2D,
+      depthTexture,
+      0);
+
+  GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+  glDrawBuffers(2, drawBuffers);
+
+  bool complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (!complete)
+  {
+    destroy();
+    throw std::runtime_error("ERROR::GBUFFER::INCOMPLETE");
+  }
+}
+
+void GBuffer::destroy() noexcept
+{
+  glDeleteFramebuffers(1, &fbo);
+  glDeleteTextures(1, &depthTexture);
+  glDeleteTextures(1, &normalTexture);
+  glDeleteTextures(1, &albedoTexture);
+}
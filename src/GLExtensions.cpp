@@ -0,0 +1,74 @@
+#include "GLExtensions.hpp"
+
+#include <cstring>
+
+#include "glad/glad.h"
+
+bool GLExtensions::bufferStorage = false;
+bool GLExtensions::multiDrawIndirect = false;
+bool GLExtensions::clipControl = false;
+
+PFNGLBUFFERSTORAGEPROC GLExtensions::glBufferStorage = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC GLExtensions::glMultiDrawElementsIndirect =
+    nullptr;
+PFNGLCLIPCONTROLPROC GLExtensions::glClipControl = nullptr;
+
+void GLExtensions::load(GLADloadproc loader)
+{
+  if (hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage"))
+  {
+    glBufferStorage =
+        reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(loader("glBufferStorage"));
+  }
+  bufferStorage = glBufferStorage != nullptr;
+
+  if (hasVersion(4, 3) || hasExtension("GL_ARB_multi_draw_indirect"))
+  {
+    glMultiDrawElementsIndirect =
+        reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTPROC>(
+            loader("glMultiDrawElementsIndirect"));
+  }
+  multiDrawIndirect = glMultiDrawElementsIndirect != nullptr;
+
+  if (hasVersion(4, 5) || hasExtension("GL_ARB_clip_control"))
+  {
+    glClipControl =
+        reinterpret_cast<PFNGLCLIPCONTROLPROC>(loader("glClipControl"));
+  }
+  clipControl = glClipControl != nullptr;
+}
+
+bool GLExtensions::hasVersion(int major, int minor) noexcept
+{
+  return GLVersion.major > major ||
+         (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+bool GLExtensions::hasExtension(const char* name) noexcept
+{
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; i++)
+  {
+    const char* extension = reinterpret_cast<const char*>(
+        glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+    if (extension != nullptr && std::strcmp(extension, name) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool GLExtensions::hasBufferStorage() noexcept
+{
+  return bufferStorage;
+}
+
+bool GLExtensions::hasMultiDrawIndirect() noexcept
+{
+  return multiDrawIndirect;
+}
+
+bool GLExtensions::hasClipControl() noexcept
+{
+  return clipControl;
+}
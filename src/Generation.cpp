@@ -0,0 +1,13 @@
+#include "Generation.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+std::atomic<std::uint64_t> Generation::counter = 0;
+
+// Cameras and projections draw from this one counter, so equal generations
+// mean equal state even across copies, and 0 is never handed out.
+std::uint64_t Generation::next() noexcept
+{
+  return ++counter;
+}
@@ -0,0 +1,64 @@
+#define GLFW_INCLUDE_NONE
+
+#include "GlfwWindow.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "GLExtensions.hpp"
+#include "glad/glad.h"
+
+static void errorCallback(int error, const char* description)
+{
+  std::ostringstream oss;
+  oss << "ERROR::GLFW (" << error << "): " << description;
+
+  throw std::runtime_error(oss.str());
+}
+
+GlfwWindow::GlfwWindow(int width, int height, const std::string& title)
+{
+  glfwSetErrorCallback(errorCallback);
+
+  if (!glfwInit())
+    throw std::runtime_error("Failed to init GLFW.");
+
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#if __APPLE__
+  glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+  window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+  if (window == nullptr)
+  {
+    glfwTerminate();
+    throw std::runtime_error("Failed to create GLFW window.");
+  }
+
+  glfwMakeContextCurrent(window);
+
+  if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+  {
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    throw std::runtime_error("Failed to initialize GLAD");
+  }
+  GLExtensions::load(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+}
+
+GlfwWindow::~GlfwWindow() noexcept
+{
+  glfwDestroyWindow(window);
+  glfwTerminate();
+}
+
+GLFWwindow* GlfwWindow::get() const noexcept
+{
+  return window;
+}
@@ -0,0 +1,232 @@
+#include "GpuCuller.hpp"
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <string>
+#include <vector>
+
+#include "CommandBuffer.hpp"
+#include "DepthPyramid.hpp"
+#include "Frustum.hpp"
+#include "GLExtensions.hpp"
+#include "Profiler.hpp"
+#include "Shader.hpp"
+#include "glad/glad.h"
+
+namespace
+{
+constexpr std::size_t TEXEL_SIZE = sizeof(glm::vec4);
+}  // namespace
+
+// Candidates are tested in a vertex shader whose outputs are captured with
+// transform feedback straight into DrawIndirectCommand records. Phase one
+// writes commandBuffers[0] from the visibility recorded in
+// commandBuffers[1] last frame; phase two reads what phase one drew and
+// writes commandBuffers[1].
+GpuCuller::GpuCuller(
+    const std::string& shaderDirectory,
+    unsigned int objectBuffer,
+    int width,
+    int height,
+    bool reverseZ)
+    : cullShader(
+          shaderDirectory + "/vertex3.glsl",
+          std::vector<std::string>{ "count",
+                                    "instanceCount",
+                                    "firstIndex",
+                                    "baseVertex",
+                                    "baseInstance" }),
+      pyramid(shaderDirectory, width, height, reverseZ),
+      width(width),
+      height(height)
+{
+  glGenBuffers(1, &candidateBuffer);
+  glGenBuffers(2, commandBuffers.data());
+  glGenVertexArrays(2, vaos.data());
+
+  const std::array<std::size_t, 2> previousOffsets = {
+    offsetof(DrawIndirectCommand, baseInstance),
+    offsetof(DrawIndirectCommand, instanceCount)
+  };
+  for (std::size_t i = 0; i < vaos.size(); i++)
+  {
+    glBindVertexArray(vaos[i]);
+
+    glBindBuffer(GL_ARRAY_BUFFER, candidateBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(CullCandidate),
+        reinterpret_cast<void*>(offsetof(CullCandidate, sphere)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(CullCandidate),
+        reinterpret_cast<void*>(offsetof(CullCandidate, cone)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(
+        2,
+        3,
+        GL_UNSIGNED_INT,
+        sizeof(CullCandidate),
+        reinterpret_cast<void*>(offsetof(CullCandidate, indexCount)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, commandBuffers[1 - i]);
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(
+        3,
+        1,
+        GL_UNSIGNED_INT,
+        sizeof(DrawIndirectCommand),
+        reinterpret_cast<void*>(previousOffsets[i]));
+  }
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  glGenTextures(1, &objectTexture);
+  glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+  glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, objectBuffer);
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+  cullShader.bind();
+  cullShader.setInt("objects", OBJECT_UNIT);
+  cullShader.setInt("depthPyramid", PYRAMID_UNIT);
+  cullShader.unbind();
+}
+
+GpuCuller::~GpuCuller() noexcept
+{
+  glDeleteTextures(1, &objectTexture);
+  glDeleteVertexArrays(2, vaos.data());
+  glDeleteBuffers(2, commandBuffers.data());
+  glDeleteBuffers(1, &candidateBuffer);
+}
+
+bool GpuCuller::isSupported(std::size_t objectBufferSize) noexcept
+{
+  if (!GLExtensions::hasMultiDrawIndirect())
+    return false;
+
+  GLint maxTexels = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+  return objectBufferSize / TEXEL_SIZE <= static_cast<std::size_t>(maxTexels);
+}
+
+void GpuCuller::resize(int width, int height)
+{
+  this->width = width;
+  this->height = height;
+  pyramid.resize(width, height);
+}
+
+// New candidates start out visible, so the first frame after re-recording
+// draws everything in phase one and seeds the pyramid from it.
+void GpuCuller::setCandidates(const std::vector<CullCandidate>& candidates)
+{
+  PROFILE_FUNCTION();
+  candidateCount = candidates.size();
+
+  glBindBuffer(GL_ARRAY_BUFFER, candidateBuffer);
+  glBufferData(
+      GL_ARRAY_BUFFER,
+      candidates.size() * sizeof(CullCandidate),
+      candidates.data(),
+      GL_STATIC_DRAW);
+
+  std::vector<DrawIndirectCommand> commands;
+  commands.reserve(candidates.size());
+  for (const auto& candidate : candidates)
+    commands.push_back({ candidate.indexCount, 0, candidate.firstIndex, 0, 1 });
+
+  for (unsigned int buffer : commandBuffers)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        commands.size() * sizeof(DrawIndirectCommand),
+        commands.data(),
+        GL_DYNAMIC_COPY);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Leaves the phase's command buffer bound to GL_DRAW_INDIRECT_BUFFER.
+void GpuCuller::cull(
+    CullPhase phase,
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    std::size_t objectBase,
+    std::size_t objectStride,
+    bool coneCulling)
+{
+  PROFILE_FUNCTION();
+  std::size_t index = phase == CullPhase::PREVIOUSLY_VISIBLE ? 0 : 1;
+
+  if (candidateCount > 0)
+  {
+    glm::mat4 viewProjection = projection * view;
+    Frustum frustum(viewProjection);
+
+    cullShader.bind();
+    cullShader.setInt("objectBase", static_cast<int>(objectBase / TEXEL_SIZE));
+    cullShader.setInt(
+        "objectStride", static_cast<int>(objectStride / TEXEL_SIZE));
+    cullShader.setMat4("viewProjection", viewProjection);
+    glUniform4fv(
+        cullShader.getUniformLocation("frustumPlanes"),
+        static_cast<GLsizei>(frustum.getPlanes().size()),
+        glm::value_ptr(frustum.getPlanes().front()));
+    cullShader.setVec3("cameraPosition", glm::vec3(glm::inverse(view)[3]));
+    cullShader.setVec2(
+        "viewportSize", static_cast<float>(width), static_cast<float>(height));
+    cullShader.setInt("pyramidLevels", pyramid.getLevelCount());
+    cullShader.setInt("phase", static_cast<int>(index + 1));
+    cullShader.setBool("coneCulling", coneCulling);
+
+    glActiveTexture(GL_TEXTURE0 + OBJECT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+    glActiveTexture(GL_TEXTURE0 + PYRAMID_UNIT);
+    glBindTexture(GL_TEXTURE_2D, pyramid.getTexture());
+    glActiveTexture(GL_TEXTURE0);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(vaos[index]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, commandBuffers[index]);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(candidateCount));
+    glEndTransformFeedback();
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+  }
+
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffers[index]);
+}
+
+void GpuCuller::buildPyramid(unsigned int framebuffer)
+{
+  pyramid.build(framebuffer);
+}
+
+// Rebinds the commands a phase last produced, e.g. to replay them for the
+// shading pass after a depth pre-pass.
+void GpuCuller::bindCommands(CullPhase phase) const noexcept
+{
+  std::size_t index = phase == CullPhase::PREVIOUSLY_VISIBLE ? 0 : 1;
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffers[index]);
+}
+
+std::size_t GpuCuller::getCandidateCount() const noexcept
+{
+  return candidateCount;
+}
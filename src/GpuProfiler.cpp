@@ -0,0 +1,155 @@
+#include "GpuProfiler.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Profiler.hpp"
+#include "glad/glad.h"
+
+GpuProfiler::GpuProfiler()
+{
+#ifdef ENABLE_PROFILER
+  track = &Profiler::createTrack("GPU");
+#endif
+
+  for (auto& frame : frames)
+  {
+    glGenQueries(
+        static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    frame.scopes.reserve(MAX_SCOPES);
+    frame.openScopes.reserve(MAX_SCOPES);
+  }
+  calibrate();
+}
+
+GpuProfiler::~GpuProfiler() noexcept
+{
+  for (auto& frame : frames)
+  {
+    glDeleteQueries(
+        static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+  }
+}
+
+void GpuProfiler::beginFrame()
+{
+  frameCount++;
+  if (frameCount % CALIBRATION_INTERVAL == 0)
+    calibrate();
+
+  Frame& frame = frames[frameCount % FRAME_LATENCY];
+  collect(frame);
+
+  frame.scopes.clear();
+  frame.openScopes.clear();
+  frame.droppedScopes = 0;
+  frame.lastQuery = 0;
+}
+
+// Scopes past MAX_SCOPES are counted rather than timed. Every scope opened
+// after the limit is nested inside the open ones, so end() unwinds the
+// dropped ones first and never closes a real scope early.
+void GpuProfiler::begin(const char* name) noexcept
+{
+  Frame& frame = frames[frameCount % FRAME_LATENCY];
+  if (frame.scopes.size() >= MAX_SCOPES)
+  {
+    frame.droppedScopes++;
+    return;
+  }
+
+  std::size_t index = frame.scopes.size();
+  frame.scopes.push_back(
+      { name, frame.queries[index * 2], frame.queries[index * 2 + 1], false });
+  frame.openScopes.push_back(index);
+
+  frame.lastQuery = frame.scopes.back().startQuery;
+  glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+}
+
+void GpuProfiler::end() noexcept
+{
+  Frame& frame = frames[frameCount % FRAME_LATENCY];
+  if (frame.droppedScopes > 0)
+  {
+    frame.droppedScopes--;
+    return;
+  }
+  if (frame.openScopes.empty())
+    return;
+
+  Scope& scope = frame.scopes[frame.openScopes.back()];
+  frame.openScopes.pop_back();
+
+  scope.closed = true;
+  frame.lastQuery = scope.endQuery;
+  glQueryCounter(frame.lastQuery, GL_TIMESTAMP);
+}
+
+const std::vector<GpuTiming>& GpuProfiler::getLastTimings() const noexcept
+{
+  return lastTimings;
+}
+
+double GpuProfiler::getLastTime(const char* name) const noexcept
+{
+  double total = 0.0;
+  for (const auto& timing : lastTimings)
+  {
+    if (std::strcmp(timing.name, name) == 0)
+      total += timing.milliseconds;
+  }
+  return total;
+}
+
+void GpuProfiler::calibrate() noexcept
+{
+  GLint64 gpuNs = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+  gpuToCpuOffsetNs = static_cast<std::int64_t>(Profiler::now()) - gpuNs;
+}
+
+void GpuProfiler::collect(Frame& frame)
+{
+  if (frame.lastQuery == 0)
+    return;
+
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE)
+    return;
+
+  lastTimings.clear();
+  for (const auto& scope : frame.scopes)
+  {
+    if (!scope.closed)
+      continue;
+
+    GLuint64 startNs = 0, endNs = 0;
+    glGetQueryObjectui64v(scope.startQuery, GL_QUERY_RESULT, &startNs);
+    glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &endNs);
+
+    lastTimings.push_back({ scope.name, (endNs - startNs) / 1'000'000.0 });
+
+#ifdef ENABLE_PROFILER
+    track->push(
+        { scope.name,
+          static_cast<std::uint64_t>(startNs + gpuToCpuOffsetNs),
+          static_cast<std::uint64_t>(endNs + gpuToCpuOffsetNs) });
+#endif
+  }
+}
+
+GpuProfileScope::GpuProfileScope(
+    GpuProfiler& profiler,
+    const char* name) noexcept
+    : profiler(profiler)
+{
+  profiler.begin(name);
+}
+
+GpuProfileScope::~GpuProfileScope() noexcept
+{
+  profiler.end();
+}
@@ -0,0 +1,154 @@
+#include "HeadlessApplication.hpp"
+
+#include <cmath>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "Camera.hpp"
+#include "CameraPath.hpp"
+#include "GLExtensions.hpp"
+#include "Image.hpp"
+#include "Model.hpp"
+#include "Projection.hpp"
+#include "Renderer.hpp"
+#include "glad/glad.h"
+
+HeadlessApplication::HeadlessApplication(const HeadlessOptions& options)
+    : options(options),
+      context(3, 3),
+      reverseZ(options.reverseZ && GLExtensions::hasClipControl()),
+      framebuffer(options.width, options.height, reverseZ),
+      camera(CameraBuilder().build()),
+      projection(
+          ProjectionBuilder()
+              .withAspectRatio(
+                  static_cast<float>(options.width) / options.height)
+              .withReverseZ(reverseZ)
+              .build()),
+      path(CameraPath::orbit(glm::vec3(0.0F), 4.0F, 1.0F, 8)),
+      model(ModelBuilder()
+                .fromFile(options.modelPath)
+                .withPositionStream(options.positionStream)
+                .withJobSystem(jobs)
+                .build()),
+      renderer(
+          RendererBuilder()
+              .withJobSystem(jobs)
+              .withViewport(options.width, options.height)
+              .withGpuCulling(options.gpuCulling)
+              .withShadows(options.shadows)
+              .withDeferredShading(options.deferred)
+              .withReverseZ(reverseZ)
+              .build()),
+      totalFrames(options.warmupFrames + options.frames),
+      captureFrame(
+          options.captureFrame >= 0 ? options.captureFrame : totalFrames - 1)
+{
+  renderer.addInstance(model, glm::mat4(1.0F), options.occluders);
+  renderer.setDepthPrepass(options.depthPrepass);
+
+  // A fixed ring of coloured point lights around the model at two heights.
+  for (int i = 0; i < options.lights; i++)
+  {
+    float angle = 6.2831853F * static_cast<float>(i) / options.lights;
+    glm::vec3 position(
+        std::cos(angle) * 2.5F,
+        (i % 2 == 0) ? 1.0F : 0.25F,
+        std::sin(angle) * 2.5F);
+    glm::vec3 color(
+        0.5F + 0.5F * std::cos(angle),
+        0.5F + 0.5F * std::cos(angle + 2.0943951F),
+        0.5F + 0.5F * std::cos(angle + 4.1887902F));
+    renderer.addPointLight({ position, 3.0F, color * 4.0F });
+  }
+  if (options.gpuCulling && !renderer.hasGpuCulling())
+    std::cerr << "GPU culling unavailable, falling back to CPU culling\n";
+  if (options.reverseZ && !reverseZ)
+    std::cerr << "Reverse-Z unavailable, falling back to forward depth\n";
+  glFinish();
+}
+
+const std::optional<Image>& HeadlessApplication::getCapture() const noexcept
+{
+  return capture;
+}
+
+const FrameStats& HeadlessApplication::getTriangleStats() const noexcept
+{
+  return triangleStats;
+}
+
+const FrameStats& HeadlessApplication::getPrepassGpuStats() const noexcept
+{
+  return prepassGpuStats;
+}
+
+const FrameStats& HeadlessApplication::getShadingGpuStats() const noexcept
+{
+  return shadingGpuStats;
+}
+
+const FrameStats& HeadlessApplication::getShadowGpuStats() const noexcept
+{
+  return shadowGpuStats;
+}
+
+const FrameStats& HeadlessApplication::getLightingGpuStats() const noexcept
+{
+  return lightingGpuStats;
+}
+
+bool HeadlessApplication::isRunning()
+{
+  return frame < totalFrames;
+}
+
+void HeadlessApplication::update([[maybe_unused]] double deltaTime)
+{
+  if (frame == options.warmupFrames)
+  {
+    frameStats.clear();
+    triangleStats.clear();
+    prepassGpuStats.clear();
+    shadingGpuStats.clear();
+    shadowGpuStats.clear();
+    lightingGpuStats.clear();
+  }
+
+  path.apply(camera, static_cast<float>(frame) / totalFrames);
+}
+
+void HeadlessApplication::render([[maybe_unused]] double alpha)
+{
+  framebuffer.bind();
+  renderer.render(camera, projection);
+  triangleStats.add(renderer.getStats().triangles);
+
+  const GpuProfiler& gpuProfiler = renderer.getGpuProfiler();
+  prepassGpuStats.add(gpuProfiler.getLastTime("DepthPrepass"));
+  shadingGpuStats.add(gpuProfiler.getLastTime("Shading"));
+  lightingGpuStats.add(gpuProfiler.getLastTime("Lighting"));
+
+  double shadowMs = 0.0;
+  for (const auto& timing : gpuProfiler.getLastTimings())
+  {
+    if (std::string_view(timing.name).starts_with("ShadowCascade"))
+      shadowMs += timing.milliseconds;
+  }
+  shadowGpuStats.add(shadowMs);
+}
+
+void HeadlessApplication::present()
+{
+  glFinish();
+}
+
+void HeadlessApplication::endFrame()
+{
+  if (frame == captureFrame)
+    capture = framebuffer.readPixels();
+
+  frame++;
+}
@@ -0,0 +1,114 @@
+#include "Image.hpp"
+
+#include <png.h>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Profiler.hpp"
+#include "stb/image.h"
+
+Image::Image(const std::string& path) : pixels(nullptr, stbi_image_free)
+{
+  PROFILE_SCOPE("Image::decode");
+  pixels.reset(stbi_load(path.c_str(), &width, &height, &channels, 0));
+
+  if (pixels == nullptr)
+  {
+    throw std::runtime_error("ERROR::STB_IMAGE::LOADING_FAILED: " + path);
+  }
+}
+
+Image::Image(int width, int height, int channels)
+    : pixels(nullptr, std::free),
+      width(width),
+      height(height),
+      channels(channels)
+{
+  pixels.reset(static_cast<unsigned char*>(std::calloc(size(), 1)));
+
+  if (pixels == nullptr)
+  {
+    throw std::runtime_error("ERROR::IMAGE::ALLOCATION_FAILED");
+  }
+}
+
+unsigned char* Image::data() const noexcept
+{
+  return pixels.get();
+}
+
+int Image::getWidth() const noexcept
+{
+  return width;
+}
+
+int Image::getHeight() const noexcept
+{
+  return height;
+}
+
+int Image::getChannels() const noexcept
+{
+  return channels;
+}
+
+std::size_t Image::size() const noexcept
+{
+  return static_cast<std::size_t>(width) * height * channels;
+}
+
+// libpng's simplified API takes a negative row stride to write bottom-up.
+void Image::writePng(const std::string& path, bool flipRows) const
+{
+  constexpr std::array<png_uint_32, 5> FORMATS = { 0,
+                                                   PNG_FORMAT_GRAY,
+                                                   PNG_FORMAT_GA,
+                                                   PNG_FORMAT_RGB,
+                                                   PNG_FORMAT_RGBA };
+
+  png_image image = {};
+  image.version = PNG_IMAGE_VERSION;
+  image.width = static_cast<png_uint_32>(width);
+  image.height = static_cast<png_uint_32>(height);
+  image.format = FORMATS.at(channels);
+
+  auto stride = static_cast<png_int_32>(width * channels);
+  if (png_image_write_to_file(
+          &image,
+          path.c_str(),
+          0,
+          pixels.get(),
+          flipRows ? -stride : stride,
+          nullptr) == 0)
+  {
+    throw std::runtime_error(
+        "ERROR::IMAGE::WRITE_FAILED: " + path + ": " + image.message);
+  }
+}
+
+double Image::psnr(const Image& a, const Image& b)
+{
+  if (a.width != b.width || a.height != b.height || a.channels != b.channels)
+  {
+    throw std::runtime_error("ERROR::IMAGE::SIZE_MISMATCH");
+  }
+
+  double squaredError = 0.0;
+  for (std::size_t i = 0; i < a.size(); i++)
+  {
+    double diff = static_cast<double>(a.pixels.get()[i]) - b.pixels.get()[i];
+    squaredError += diff * diff;
+  }
+
+  if (squaredError == 0.0)
+    return std::numeric_limits<double>::infinity();
+
+  double mse = squaredError / a.size();
+  return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
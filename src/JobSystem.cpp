@@ -0,0 +1,236 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Profiler.hpp"
+
+namespace
+{
+// Queue 0 is shared by threads outside the pool; workers own queues 1..N.
+thread_local const JobSystem* localSystem = nullptr;
+thread_local std::size_t localQueue = 0;
+}  // namespace
+
+bool JobCounter::isDone() const noexcept
+{
+  return pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+  for (unsigned int i = 0; i <= workerCount; i++)
+    queues.push_back(std::make_unique<WorkQueue>());
+
+  for (unsigned int i = 1; i <= workerCount; i++)
+    workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() noexcept
+{
+  {
+    std::lock_guard lock(sleepMutex);
+    running = false;
+  }
+  wake.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+}
+
+unsigned int JobSystem::defaultWorkerCount() noexcept
+{
+  unsigned int cores = std::thread::hardware_concurrency();
+  return cores > 1 ? cores - 1 : 0;
+}
+
+unsigned int JobSystem::getWorkerCount() const noexcept
+{
+  return static_cast<unsigned int>(workers.size());
+}
+
+void JobSystem::submit(std::function<void()> task, JobCounter& counter)
+{
+  counter.pending.fetch_add(1, std::memory_order_relaxed);
+  push({ std::move(task), &counter, nullptr });
+}
+
+// Jobs whose dependency is still pending are parked off the queues, so
+// workers can sleep instead of popping and re-queuing them.
+void JobSystem::submitAfter(
+    const JobCounter& dependency,
+    std::function<void()> task,
+    JobCounter& counter)
+{
+  counter.pending.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard lock(blockedMutex);
+    if (!dependency.isDone())
+    {
+      blockedJobs.push_back({ std::move(task), &counter, &dependency });
+      return;
+    }
+  }
+  push({ std::move(task), &counter, nullptr });
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+  PROFILE_SCOPE("JobSystem::wait");
+  std::size_t queue = currentQueue();
+
+  while (!counter.isDone())
+  {
+    if (!tryRun(queue))
+      std::this_thread::yield();
+  }
+
+  std::exception_ptr error;
+  {
+    std::lock_guard lock(counter.errorMutex);
+    error = std::exchange(counter.error, nullptr);
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void JobSystem::parallelFor(
+    std::size_t count,
+    std::size_t grainSize,
+    const std::function<void(std::size_t, std::size_t)>& body)
+{
+  if (count == 0)
+    return;
+
+  grainSize = std::max<std::size_t>(grainSize, 1);
+
+  JobCounter counter;
+  for (std::size_t begin = 0; begin < count; begin += grainSize)
+  {
+    std::size_t end = std::min(count, begin + grainSize);
+    submit([&body, begin, end] { body(begin, end); }, counter);
+  }
+  wait(counter);
+}
+
+std::size_t JobSystem::currentQueue() const noexcept
+{
+  return localSystem == this ? localQueue : 0;
+}
+
+void JobSystem::push(Job&& job)
+{
+  WorkQueue& queue = *queues[currentQueue()];
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+  {
+    std::lock_guard lock(sleepMutex);
+    queuedJobs.fetch_add(1, std::memory_order_relaxed);
+  }
+  wake.notify_one();
+}
+
+std::optional<JobSystem::Job> JobSystem::pop(std::size_t queue)
+{
+  // Owners take their newest job for locality, thieves take the oldest.
+  {
+    WorkQueue& own = *queues[queue];
+    std::lock_guard lock(own.mutex);
+    if (!own.jobs.empty())
+    {
+      Job job = std::move(own.jobs.back());
+      own.jobs.pop_back();
+      return job;
+    }
+  }
+
+  for (std::size_t i = 1; i < queues.size(); i++)
+  {
+    WorkQueue& victim = *queues[(queue + i) % queues.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.jobs.empty())
+    {
+      Job job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      return job;
+    }
+  }
+
+  return std::nullopt;
+}
+
+bool JobSystem::tryRun(std::size_t queue)
+{
+  std::optional<Job> job = pop(queue);
+  if (!job)
+    return false;
+
+  queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+  try
+  {
+    job->task();
+  }
+  catch (...)
+  {
+    std::lock_guard lock(job->counter->errorMutex);
+    if (!job->counter->error)
+      job->counter->error = std::current_exception();
+  }
+
+  // The counter may be destroyed as soon as it reaches zero, so it is not
+  // touched again here.
+  if (job->counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    releaseBlocked();
+  return true;
+}
+
+// Parked jobs keep their dependency alive until they run, so checking each
+// one is safe even though the counter that just finished may be gone.
+void JobSystem::releaseBlocked()
+{
+  std::vector<Job> ready;
+  {
+    std::lock_guard lock(blockedMutex);
+    auto blocked = std::stable_partition(
+        blockedJobs.begin(),
+        blockedJobs.end(),
+        [](const Job& job) { return !job.dependency->isDone(); });
+    std::move(blocked, blockedJobs.end(), std::back_inserter(ready));
+    blockedJobs.erase(blocked, blockedJobs.end());
+  }
+
+  for (auto& job : ready)
+    push(std::move(job));
+}
+
+void JobSystem::workerLoop(std::size_t queue)
+{
+  localSystem = this;
+  localQueue = queue;
+
+  PROFILE_THREAD("Worker");
+
+  while (running)
+  {
+    if (tryRun(queue))
+      continue;
+
+    std::unique_lock lock(sleepMutex);
+    wake.wait(
+        lock,
+        [this]
+        { return queuedJobs.load(std::memory_order_relaxed) > 0 || !running; });
+  }
+}
@@ -0,0 +1,164 @@
+#include "LightGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Profiler.hpp"
+#include "glad/glad.h"
+
+LightGrid::LightGrid(int width, int height)
+{
+  glGenBuffers(1, &lightBuffer);
+  glGenBuffers(1, &tileBuffer);
+  glGenTextures(1, &lightTexture);
+  glGenTextures(1, &tileTexture);
+
+  resize(width, height);
+}
+
+LightGrid::~LightGrid() noexcept
+{
+  glDeleteTextures(1, &tileTexture);
+  glDeleteTextures(1, &lightTexture);
+  glDeleteBuffers(1, &tileBuffer);
+  glDeleteBuffers(1, &lightBuffer);
+}
+
+void LightGrid::resize(int width, int height)
+{
+  this->width = width;
+  this->height = height;
+  tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+  tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+  bins.resize(static_cast<std::size_t>(tilesX * tilesY));
+}
+
+// Lights are stored as two texels, (position, radius) and (color, 0). The
+// tile buffer starts with an (offset, count) pair per tile into the light
+// indices that follow. Each light's screen rectangle comes from the eight
+// corners of its view-space bounding box, which is conservative; lights
+// crossing the near plane cover the whole screen.
+void LightGrid::build(
+    const std::vector<PointLight>& lights,
+    const glm::mat4& view,
+    const glm::mat4& projection)
+{
+  PROFILE_FUNCTION();
+  float near = projection[3][2] / (projection[2][2] - 1.0F);
+
+  lightCount = lights.size();
+  lightData.clear();
+  for (auto& bin : bins)
+    bin.clear();
+
+  for (std::size_t i = 0; i < lights.size(); i++)
+  {
+    const PointLight& light = lights[i];
+    lightData.emplace_back(light.position, light.radius);
+    lightData.emplace_back(light.color, 0.0F);
+
+    glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0F));
+    if (center.z - light.radius > -near)
+      continue;
+
+    glm::vec2 minNdc(-1.0F), maxNdc(1.0F);
+    if (center.z + light.radius < -near)
+    {
+      minNdc = glm::vec2(1.0F);
+      maxNdc = glm::vec2(-1.0F);
+      for (int k = 0; k < 8; k++)
+      {
+        glm::vec3 offset((k & 1) != 0 ? 1.0F : -1.0F,
+                         (k & 2) != 0 ? 1.0F : -1.0F,
+                         (k & 4) != 0 ? 1.0F : -1.0F);
+        glm::vec4 clip =
+            projection * glm::vec4(center + offset * light.radius, 1.0F);
+        glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        minNdc = glm::min(minNdc, ndc);
+        maxNdc = glm::max(maxNdc, ndc);
+      }
+    }
+
+    if (maxNdc.x < -1.0F || minNdc.x > 1.0F || maxNdc.y < -1.0F ||
+        minNdc.y > 1.0F)
+    {
+      continue;
+    }
+
+    auto toTile = [](float ndc, int size, int tiles)
+    {
+      int pixel = static_cast<int>(std::floor((ndc * 0.5F + 0.5F) * size));
+      return std::clamp(pixel / TILE_SIZE, 0, tiles - 1);
+    };
+
+    int minX = toTile(minNdc.x, width, tilesX);
+    int maxX = toTile(maxNdc.x, width, tilesX);
+    int minY = toTile(minNdc.y, height, tilesY);
+    int maxY = toTile(maxNdc.y, height, tilesY);
+    for (int y = minY; y <= maxY; y++)
+    {
+      for (int x = minX; x <= maxX; x++)
+      {
+        bins[static_cast<std::size_t>(y * tilesX + x)].push_back(
+            static_cast<unsigned int>(i));
+      }
+    }
+  }
+
+  tileData.assign(bins.size() * 2, 0);
+  for (std::size_t tile = 0; tile < bins.size(); tile++)
+  {
+    tileData[tile * 2] = static_cast<unsigned int>(tileData.size());
+    tileData[tile * 2 + 1] = static_cast<unsigned int>(bins[tile].size());
+    tileData.insert(tileData.end(), bins[tile].begin(), bins[tile].end());
+  }
+
+  // Texture buffers must not be empty.
+  if (lightData.empty())
+    lightData.resize(2, glm::vec4(0.0F));
+
+  glBindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+  glBufferData(
+      GL_TEXTURE_BUFFER,
+      lightData.size() * sizeof(glm::vec4),
+      lightData.data(),
+      GL_STREAM_DRAW);
+  glBindBuffer(GL_TEXTURE_BUFFER, tileBuffer);
+  glBufferData(
+      GL_TEXTURE_BUFFER,
+      tileData.size() * sizeof(unsigned int),
+      tileData.data(),
+      GL_STREAM_DRAW);
+  glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+  // Reattached after every upload; some drivers keep the old data store
+  // otherwise.
+  glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+  glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+  glBindTexture(GL_TEXTURE_BUFFER, tileTexture);
+  glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, tileBuffer);
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+unsigned int LightGrid::getLightTexture() const noexcept
+{
+  return lightTexture;
+}
+
+unsigned int LightGrid::getTileTexture() const noexcept
+{
+  return tileTexture;
+}
+
+int LightGrid::getTilesX() const noexcept
+{
+  return tilesX;
+}
+
+std::size_t LightGrid::getLightCount() const noexcept
+{
+  return lightCount;
+}
@@ -1,21 +1,53 @@
 #include "Mesh.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <glm/glm.hpp>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "CommandBuffer.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "TextureBinder.hpp"
 #include "glad/glad.h"
 
 Mesh::Mesh(
     std::vector<Vertex>&& vert,
     std::vector<unsigned int>&& ind,
-    TextureVector&& tex)
+    TextureVector&& tex,
+    TextureLayerVector&& texLayers,
+    LodVector&& meshLods,
+    MeshletVector&& meshMeshlets,
+    bool positionStream)
     : vertices(std::move(vert)),
       indices(std::move(ind)),
-      textures(std::move(tex))
+      textures(std::move(tex)),
+      textureLayers(std::move(texLayers)),
+      lods(std::move(meshLods)),
+      meshlets(std::move(meshMeshlets))
 {
+  if (lods.empty())
+    lods.push_back({ 0, static_cast<unsigned int>(indices.size()), 0.0F });
+
+  glm::vec3 minCorner(0.0F), maxCorner(0.0F);
+  if (!vertices.empty())
+    minCorner = maxCorner = vertices.front().position;
+  for (const auto& vertex : vertices)
+  {
+    minCorner = glm::min(minCorner, vertex.position);
+    maxCorner = glm::max(maxCorner, vertex.position);
+  }
+
+  bounds = { (minCorner + maxCorner) * 0.5F, 0.0F };
+  for (const auto& vertex : vertices)
+  {
+    bounds.radius =
+        std::max(bounds.radius, glm::distance(bounds.center, vertex.position));
+  }
+
   glGenVertexArrays(1, &vao);
   glGenBuffers(1, &vbo);
   glGenBuffers(1, &ebo);
@@ -60,10 +92,15 @@ Mesh::Mesh(
   glBindVertexArray(0);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  if (positionStream)
+    createPositionStream();
 }
 
 Mesh::~Mesh() noexcept
 {
+  glDeleteBuffers(1, &positionVbo);
+  glDeleteVertexArrays(1, &positionVao);
   glDeleteBuffers(1, &ebo);
   glDeleteBuffers(1, &vbo);
   glDeleteVertexArrays(1, &vao);
@@ -73,13 +110,22 @@ Mesh::Mesh(Mesh&& other)
     : vao(other.vao),
       vbo(other.vbo),
       ebo(other.ebo),
+      positionVao(other.positionVao),
+      positionVbo(other.positionVbo),
       vertices(std::move(other.vertices)),
+      positions(std::move(other.positions)),
       indices(std::move(other.indices)),
-      textures(std::move(other.textures))
+      textures(std::move(other.textures)),
+      textureLayers(std::move(other.textureLayers)),
+      lods(std::move(other.lods)),
+      meshlets(std::move(other.meshlets)),
+      bounds(other.bounds)
 {
   other.vao = 0;
   other.vbo = 0;
   other.ebo = 0;
+  other.positionVao = 0;
+  other.positionVbo = 0;
 }
 
 Mesh& Mesh::operator=(Mesh&& other)
@@ -89,46 +135,292 @@ Mesh& Mesh::operator=(Mesh&& other)
     glDeleteVertexArrays(1, &vao);
     glDeleteBuffers(1, &vbo);
     glDeleteBuffers(1, &ebo);
+    glDeleteVertexArrays(1, &positionVao);
+    glDeleteBuffers(1, &positionVbo);
 
     vao = other.vao;
     vbo = other.vbo;
     ebo = other.ebo;
+    positionVao = other.positionVao;
+    positionVbo = other.positionVbo;
     vertices = std::move(other.vertices);
+    positions = std::move(other.positions);
     indices = std::move(other.indices);
     textures = std::move(other.textures);
+    textureLayers = std::move(other.textureLayers);
+    lods = std::move(other.lods);
+    meshlets = std::move(other.meshlets);
+    bounds = other.bounds;
 
     other.vao = 0;
     other.vbo = 0;
     other.ebo = 0;
+    other.positionVao = 0;
+    other.positionVbo = 0;
   }
   return *this;
 }
 
 void Mesh::draw(const Shader& shader) const
+{
+  TextureBinder binder;
+  draw(shader, binder);
+}
+
+// Expects the shader's samplers set by setMaterialSamplers and, for packed
+// textures, the layers in the bound Object block.
+void Mesh::draw(const Shader& shader, TextureBinder& binder) const
 {
   unsigned int diffuseNr = 1, specularNr = 1;
 
-  for (unsigned int i = 0; i < textures.size(); i++)
+  shader.bind();
+  for (const auto& texture : textures)
+  {
+    unsigned int number = 0;
+    switch (texture->getType())
+    {
+      case Texture::Type::DIFFUSE: number = diffuseNr++; break;
+      case Texture::Type::SPECULAR: number = specularNr++; break;
+    }
+
+    if (number <= MAX_MATERIAL_TEXTURES)
+    {
+      binder.bind(
+          materialUnit(texture->getType(), number),
+          GL_TEXTURE_2D,
+          texture->getId());
+    }
+  }
+
+  for (const auto& layer : textureLayers)
   {
-    glActiveTexture(GL_TEXTURE0 + i);
-    int number;
-    switch (textures[i]->getType())
+    unsigned int number = 0;
+    switch (layer.type)
     {
       case Texture::Type::DIFFUSE: number = diffuseNr++; break;
       case Texture::Type::SPECULAR: number = specularNr++; break;
     }
 
-    shader.setInt(
-        "material." + textures[i]->typeStr() + std::to_string(number), i);
-    glBindTexture(GL_TEXTURE_2D, textures[i]->getId());
+    if (number <= MAX_MATERIAL_TEXTURES)
+    {
+      binder.bind(
+          materialUnit(layer.type, number),
+          GL_TEXTURE_2D_ARRAY,
+          layer.array->getId());
+    }
   }
   glActiveTexture(GL_TEXTURE0);
 
   glBindVertexArray(vao);
-  glDrawElements(
-      GL_TRIANGLES,
-      static_cast<unsigned int>(indices.size()),
-      GL_UNSIGNED_INT,
-      nullptr);
+  glDrawElements(GL_TRIANGLES, lods[0].indexCount, GL_UNSIGNED_INT, nullptr);
   glBindVertexArray(0);
 }
+
+void Mesh::record(
+    const Shader& shader,
+    CommandBuffer& commands,
+    std::size_t lod) const
+{
+  recordMaterial(shader, commands);
+
+  const MeshLod& selected = lods[std::min(lod, lods.size() - 1)];
+  commands.bindVertexArray(vao, positionVao);
+  commands.drawElements(selected.indexCount, selected.firstIndex);
+}
+
+void Mesh::recordMultiDraw(
+    const Shader& shader,
+    CommandBuffer& commands,
+    std::size_t rangeSlot) const
+{
+  recordMaterial(shader, commands);
+
+  commands.bindVertexArray(vao, positionVao);
+  commands.multiDrawElements(rangeSlot);
+}
+
+void Mesh::recordIndirect(
+    const Shader& shader,
+    CommandBuffer& commands,
+    std::size_t firstCommand,
+    unsigned int commandCount) const
+{
+  recordMaterial(shader, commands);
+
+  commands.bindVertexArray(vao, positionVao);
+  commands.multiDrawElementsIndirect(firstCommand, commandCount);
+}
+
+// A tightly packed copy of the positions sharing the index buffer, so depth
+// and shadow passes fetch 12 bytes per vertex instead of a whole Vertex.
+void Mesh::createPositionStream()
+{
+  positions.reserve(vertices.size());
+  for (const auto& vertex : vertices)
+    positions.push_back(vertex.position);
+
+  glGenVertexArrays(1, &positionVao);
+  glGenBuffers(1, &positionVbo);
+
+  glBindVertexArray(positionVao);
+
+  glBindBuffer(GL_ARRAY_BUFFER, positionVbo);
+  glBufferData(
+      GL_ARRAY_BUFFER,
+      positions.size() * sizeof(glm::vec3),
+      positions.data(),
+      GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+  glEnableVertexAttribArray(0);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+// Only texture binds are recorded: sampler units are fixed per program and
+// packed layers travel in the Object block, so replay issues no glUniform*.
+void Mesh::recordMaterial(const Shader& shader, CommandBuffer& commands) const
+{
+  unsigned int diffuseNr = 1, specularNr = 1;
+
+  commands.useProgram(shader.getProgramId());
+
+  for (const auto& texture : textures)
+  {
+    unsigned int number = 0;
+    switch (texture->getType())
+    {
+      case Texture::Type::DIFFUSE: number = diffuseNr++; break;
+      case Texture::Type::SPECULAR: number = specularNr++; break;
+    }
+
+    if (number <= MAX_MATERIAL_TEXTURES)
+    {
+      commands.bindTexture(
+          materialUnit(texture->getType(), number),
+          GL_TEXTURE_2D,
+          texture->getId());
+    }
+  }
+
+  for (const auto& layer : textureLayers)
+  {
+    unsigned int number = 0;
+    switch (layer.type)
+    {
+      case Texture::Type::DIFFUSE: number = diffuseNr++; break;
+      case Texture::Type::SPECULAR: number = specularNr++; break;
+    }
+
+    if (number <= MAX_MATERIAL_TEXTURES)
+    {
+      commands.bindTexture(
+          materialUnit(layer.type, number),
+          GL_TEXTURE_2D_ARRAY,
+          layer.array->getId());
+    }
+  }
+}
+
+unsigned int Mesh::getIndexCount(std::size_t lod) const noexcept
+{
+  return lods[std::min(lod, lods.size() - 1)].indexCount;
+}
+
+const std::vector<Vertex>& Mesh::getVertices() const noexcept
+{
+  return vertices;
+}
+
+const std::vector<glm::vec3>& Mesh::getPositions() const noexcept
+{
+  return positions;
+}
+
+bool Mesh::hasPositionStream() const noexcept
+{
+  return positionVao != 0;
+}
+
+const std::vector<unsigned int>& Mesh::getIndices() const noexcept
+{
+  return indices;
+}
+
+const Mesh::LodVector& Mesh::getLods() const noexcept
+{
+  return lods;
+}
+
+const Mesh::MeshletVector& Mesh::getMeshlets() const noexcept
+{
+  return meshlets;
+}
+
+const BoundingSphere& Mesh::getBounds() const noexcept
+{
+  return bounds;
+}
+
+const Mesh::TextureVector& Mesh::getTextures() const noexcept
+{
+  return textures;
+}
+
+const Mesh::TextureLayerVector& Mesh::getTextureLayers() const noexcept
+{
+  return textureLayers;
+}
+
+// Array layers of the first packed diffuse and specular texture in x and y,
+// as the Object block carries them to shaders sampling packed materials.
+glm::vec4 Mesh::getMaterialLayers() const noexcept
+{
+  glm::vec4 layers(0.0F);
+  bool diffuseFound = false, specularFound = false;
+  for (const auto& layer : textureLayers)
+  {
+    if (layer.type == Texture::Type::DIFFUSE && !diffuseFound)
+    {
+      layers.x = static_cast<float>(layer.layer);
+      diffuseFound = true;
+    }
+    else if (layer.type == Texture::Type::SPECULAR && !specularFound)
+    {
+      layers.y = static_cast<float>(layer.layer);
+      specularFound = true;
+    }
+  }
+  return layers;
+}
+
+// Diffuse textures take units [0, MAX_MATERIAL_TEXTURES) and specular ones
+// the next MAX_MATERIAL_TEXTURES, numbered from 1 like the sampler names.
+unsigned int Mesh::materialUnit(
+    Texture::Type type,
+    unsigned int number) noexcept
+{
+  unsigned int base =
+      type == Texture::Type::DIFFUSE ? 0 : MAX_MATERIAL_TEXTURES;
+  return base + number - 1;
+}
+
+// Points every material sampler at its fixed unit; called once per program
+// after linking.
+void Mesh::setMaterialSamplers(const Shader& shader)
+{
+  shader.bind();
+  for (auto type : { Texture::Type::DIFFUSE, Texture::Type::SPECULAR })
+  {
+    for (unsigned int number = 1; number <= MAX_MATERIAL_TEXTURES; number++)
+    {
+      shader.setInt(
+          "material." + Texture::typeStr(type) + std::to_string(number),
+          static_cast<int>(materialUnit(type, number)));
+    }
+  }
+  shader.unbind();
+}
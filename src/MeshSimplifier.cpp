@@ -0,0 +1,314 @@
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Mesh.hpp"
+#include "Profiler.hpp"
+
+namespace
+{
+// Symmetric 4x4 plane quadric stored as its upper triangle, plus the total
+// area it was accumulated from so errors stay in squared distance units.
+struct Quadric
+{
+  std::array<double, 10> m {};
+  double weight = 0.0;
+
+  void addPlane(glm::vec3 normal, float distance, double area) noexcept
+  {
+    double a = normal.x, b = normal.y, c = normal.z, d = distance;
+    double values[10] = { a * a, a * b, a * c, a * d, b * b,
+                          b * c, b * d, c * c, c * d, d * d };
+    for (std::size_t i = 0; i < m.size(); i++)
+      m[i] += values[i] * area;
+    weight += area;
+  }
+
+  Quadric& operator+=(const Quadric& other) noexcept
+  {
+    for (std::size_t i = 0; i < m.size(); i++)
+      m[i] += other.m[i];
+    weight += other.weight;
+    return *this;
+  }
+
+  double evaluate(glm::vec3 p) const noexcept
+  {
+    double x = p.x, y = p.y, z = p.z;
+    double error = m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z +
+                   2 * m[3] * x + m[4] * y * y + 2 * m[5] * y * z +
+                   2 * m[6] * y + m[7] * z * z + 2 * m[8] * z + m[9];
+    return std::max(error, 0.0) / std::max(weight, 1e-12);
+  }
+};
+
+struct Collapse
+{
+  double cost;
+  unsigned int from, to;
+  unsigned int fromVersion, toVersion;
+
+  bool operator>(const Collapse& other) const noexcept
+  {
+    return cost > other.cost;
+  }
+};
+
+using Triangle = std::array<unsigned int, 3>;
+
+glm::vec3 faceNormal(glm::vec3 a, glm::vec3 b, glm::vec3 c) noexcept
+{
+  return glm::cross(b - a, c - a);
+}
+
+std::uint64_t edgeKey(unsigned int a, unsigned int b) noexcept
+{
+  if (a > b)
+    std::swap(a, b);
+  return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+}  // namespace
+
+SimplifiedIndices MeshSimplifier::simplify(
+    const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices,
+    std::size_t targetIndexCount)
+{
+  PROFILE_FUNCTION();
+  const std::size_t vertexCount = vertices.size();
+
+  std::vector<Triangle> triangles;
+  triangles.reserve(indices.size() / 3);
+  for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+    triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+
+  std::vector<bool> alive(triangles.size(), true);
+  std::size_t liveTriangles = triangles.size();
+
+  std::vector<Quadric> quadrics(vertexCount);
+  std::vector<std::vector<unsigned int>> vertexTriangles(vertexCount);
+  std::unordered_map<std::uint64_t, unsigned int> edgeUses;
+
+  for (unsigned int t = 0; t < triangles.size(); t++)
+  {
+    const Triangle& tri = triangles[t];
+    glm::vec3 p0 = vertices[tri[0]].position;
+    glm::vec3 normal =
+        faceNormal(p0, vertices[tri[1]].position, vertices[tri[2]].position);
+    float doubleArea = glm::length(normal);
+
+    if (doubleArea > 0.0F)
+    {
+      normal = normal / doubleArea;
+      for (unsigned int corner : tri)
+      {
+        quadrics[corner].addPlane(
+            normal, -glm::dot(normal, p0), 0.5 * doubleArea);
+      }
+    }
+
+    for (std::size_t k = 0; k < 3; k++)
+    {
+      vertexTriangles[tri[k]].push_back(t);
+      edgeUses[edgeKey(tri[k], tri[(k + 1) % 3])]++;
+    }
+  }
+
+  // Open borders and attribute seams (several vertices sharing a position)
+  // stay in place so the simplified mesh keeps its outline and UV layout.
+  std::vector<bool> locked(vertexCount, false);
+  for (const auto& [key, uses] : edgeUses)
+  {
+    if (uses == 1)
+    {
+      locked[key >> 32] = true;
+      locked[key & 0xFFFFFFFF] = true;
+    }
+  }
+
+  std::map<std::tuple<float, float, float>, unsigned int> positions;
+  for (unsigned int v = 0; v < vertexCount; v++)
+  {
+    if (vertexTriangles[v].empty())
+      continue;
+
+    glm::vec3 p = vertices[v].position;
+    auto [it, inserted] = positions.try_emplace({ p.x, p.y, p.z }, v);
+    if (!inserted)
+    {
+      locked[v] = true;
+      locked[it->second] = true;
+    }
+  }
+
+  std::vector<unsigned int> collapsedInto(vertexCount);
+  std::vector<unsigned int> versions(vertexCount, 0);
+  for (unsigned int v = 0; v < vertexCount; v++)
+    collapsedInto[v] = v;
+
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> queue;
+  auto pushCollapse = [&](unsigned int from, unsigned int to)
+  {
+    if (locked[from])
+      return;
+
+    Quadric combined = quadrics[from];
+    combined += quadrics[to];
+    queue.push({ combined.evaluate(vertices[to].position),
+                 from,
+                 to,
+                 versions[from],
+                 versions[to] });
+  };
+  auto pushNeighbours = [&](unsigned int v)
+  {
+    for (unsigned int t : vertexTriangles[v])
+    {
+      if (!alive[t])
+        continue;
+      for (unsigned int w : triangles[t])
+      {
+        if (w == v)
+          continue;
+        pushCollapse(v, w);
+        pushCollapse(w, v);
+      }
+    }
+  };
+
+  for (const auto& [key, uses] : edgeUses)
+  {
+    auto a = static_cast<unsigned int>(key >> 32);
+    auto b = static_cast<unsigned int>(key & 0xFFFFFFFF);
+    pushCollapse(a, b);
+    pushCollapse(b, a);
+  }
+
+  double maxCost = 0.0;
+  while (liveTriangles * 3 > targetIndexCount && !queue.empty())
+  {
+    Collapse collapse = queue.top();
+    queue.pop();
+
+    unsigned int from = collapse.from, to = collapse.to;
+    if (collapsedInto[from] != from || collapsedInto[to] != to ||
+        versions[from] != collapse.fromVersion ||
+        versions[to] != collapse.toVersion)
+    {
+      continue;
+    }
+
+    // Reject collapses that would fold a surviving triangle over.
+    bool flips = false;
+    for (unsigned int t : vertexTriangles[from])
+    {
+      const Triangle& tri = triangles[t];
+      if (!alive[t] || std::find(tri.begin(), tri.end(), to) != tri.end())
+        continue;
+
+      std::array<glm::vec3, 3> corners;
+      for (std::size_t k = 0; k < 3; k++)
+        corners[k] = vertices[tri[k]].position;
+      glm::vec3 before = faceNormal(corners[0], corners[1], corners[2]);
+
+      for (std::size_t k = 0; k < 3; k++)
+      {
+        if (tri[k] == from)
+          corners[k] = vertices[to].position;
+      }
+      glm::vec3 after = faceNormal(corners[0], corners[1], corners[2]);
+
+      if (glm::dot(before, after) <= 0.0F)
+      {
+        flips = true;
+        break;
+      }
+    }
+    if (flips)
+      continue;
+
+    for (unsigned int t : vertexTriangles[from])
+    {
+      if (!alive[t])
+        continue;
+
+      Triangle& tri = triangles[t];
+      if (std::find(tri.begin(), tri.end(), to) != tri.end())
+      {
+        alive[t] = false;
+        liveTriangles--;
+        continue;
+      }
+
+      std::replace(tri.begin(), tri.end(), from, to);
+      vertexTriangles[to].push_back(t);
+    }
+
+    quadrics[to] += quadrics[from];
+    collapsedInto[from] = to;
+    versions[from]++;
+    versions[to]++;
+    maxCost = std::max(maxCost, collapse.cost);
+
+    pushNeighbours(to);
+  }
+
+  SimplifiedIndices result;
+  result.indices.reserve(liveTriangles * 3);
+  for (std::size_t t = 0; t < triangles.size(); t++)
+  {
+    if (alive[t])
+      result.indices.insert(
+          result.indices.end(), triangles[t].begin(), triangles[t].end());
+  }
+  result.error = static_cast<float>(std::sqrt(maxCost));
+
+  return result;
+}
+
+std::vector<MeshLod> MeshSimplifier::generateLods(
+    const std::vector<Vertex>& vertices,
+    std::vector<unsigned int>& indices)
+{
+  PROFILE_FUNCTION();
+  std::vector<MeshLod> lods = {
+    { 0, static_cast<unsigned int>(indices.size()), 0.0F }
+  };
+
+  std::vector<unsigned int> source = indices;
+  float error = 0.0F;
+  while (lods.size() < MAX_LODS)
+  {
+    std::size_t target =
+        static_cast<std::size_t>(source.size() / 3 * LOD_REDUCTION) * 3;
+    if (target / 3 < MIN_LOD_TRIANGLES)
+      break;
+
+    SimplifiedIndices simplified = simplify(vertices, source, target);
+    if (simplified.indices.size() > source.size() * MIN_LOD_PROGRESS)
+      break;
+
+    // Each level is simplified from the previous one, so errors accumulate.
+    error += simplified.error;
+    lods.push_back({ static_cast<unsigned int>(indices.size()),
+                     static_cast<unsigned int>(simplified.indices.size()),
+                     error });
+
+    indices.insert(
+        indices.end(), simplified.indices.begin(), simplified.indices.end());
+    source = std::move(simplified.indices);
+  }
+
+  return lods;
+}
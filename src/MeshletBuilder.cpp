@@ -0,0 +1,130 @@
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Mesh.hpp"
+#include "Profiler.hpp"
+
+// Splits the first indexCount indices into runs of whole triangles that
+// touch at most MAX_VERTICES distinct vertices. The importer emits
+// triangles with good locality, so runs stay spatially compact without
+// reordering the index buffer, and each meshlet remains a contiguous range.
+std::vector<Meshlet> MeshletBuilder::build(
+    const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices,
+    std::size_t indexCount)
+{
+  PROFILE_FUNCTION();
+  std::vector<Meshlet> meshlets;
+  std::vector<std::size_t> owner(vertices.size(), 0);
+
+  std::size_t current = 1;
+  std::size_t first = 0;
+  std::size_t vertexCount = 0;
+
+  auto newVertices = [&](std::size_t t)
+  {
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < 3; k++)
+    {
+      unsigned int v = indices[t + k];
+      bool repeated = (k > 0 && indices[t] == v) ||
+                      (k > 1 && indices[t + 1] == v);
+      if (owner[v] != current && !repeated)
+        count++;
+    }
+    return count;
+  };
+
+  for (std::size_t t = 0; t + 2 < indexCount; t += 3)
+  {
+    std::size_t added = newVertices(t);
+    if (vertexCount + added > MAX_VERTICES ||
+        (t - first) / 3 + 1 > MAX_TRIANGLES)
+    {
+      meshlets.push_back(finish(vertices, indices, first, t - first));
+      current++;
+      first = t;
+      vertexCount = 0;
+      added = newVertices(t);
+    }
+
+    for (std::size_t k = 0; k < 3; k++)
+      owner[indices[t + k]] = current;
+    vertexCount += added;
+  }
+
+  std::size_t end = indexCount - indexCount % 3;
+  if (end > first)
+    meshlets.push_back(finish(vertices, indices, first, end - first));
+
+  return meshlets;
+}
+
+// The normal cone follows the usual cluster culling formulation: the axis is
+// the averaged face normal and the cutoff is sin of the widest deviation, so
+// a cluster is entirely back-facing when
+// dot(center - eye, axis) >= cutoff * |center - eye| + radius.
+Meshlet MeshletBuilder::finish(
+    const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices,
+    std::size_t firstIndex,
+    std::size_t indexCount)
+{
+  glm::vec3 min(INFINITY);
+  glm::vec3 max(-INFINITY);
+  for (std::size_t i = firstIndex; i < firstIndex + indexCount; i++)
+  {
+    min = glm::min(min, vertices[indices[i]].position);
+    max = glm::max(max, vertices[indices[i]].position);
+  }
+
+  glm::vec3 center = (min + max) * 0.5F;
+  float radius = 0.0F;
+  for (std::size_t i = firstIndex; i < firstIndex + indexCount; i++)
+  {
+    radius = std::max(
+        radius, glm::length(vertices[indices[i]].position - center));
+  }
+
+  std::vector<glm::vec3> normals;
+  glm::vec3 axis(0.0F);
+  for (std::size_t i = firstIndex; i < firstIndex + indexCount; i += 3)
+  {
+    const glm::vec3& a = vertices[indices[i]].position;
+    const glm::vec3& b = vertices[indices[i + 1]].position;
+    const glm::vec3& c = vertices[indices[i + 2]].position;
+
+    glm::vec3 normal = glm::cross(b - a, c - a);
+    float length = glm::length(normal);
+    if (length <= 0.0F)
+      continue;
+
+    normals.push_back(normal / length);
+    axis += normals.back();
+  }
+
+  float axisLength = glm::length(axis);
+  float cutoff = 1.0F;
+  if (axisLength > 0.0F)
+  {
+    axis = axis / axisLength;
+
+    float minDot = 1.0F;
+    for (const auto& normal : normals)
+      minDot = std::min(minDot, glm::dot(normal, axis));
+
+    if (minDot > 0.0F)
+      cutoff = std::sqrt(1.0F - minDot * minDot);
+  }
+
+  return { static_cast<unsigned int>(firstIndex),
+           static_cast<unsigned int>(indexCount),
+           { center, radius },
+           axis,
+           cutoff };
+}
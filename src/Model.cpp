@@ -3,26 +3,59 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <array>
 #include <assimp/Importer.hpp>
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <glm/glm.hpp>
+#include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include "CommandBuffer.hpp"
+#include "Image.hpp"
+#include "JobSystem.hpp"
+#include "MeshSimplifier.hpp"
+#include "MeshletBuilder.hpp"
+#include "Profiler.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "TextureBinder.hpp"
+#include "TextureStreamer.hpp"
 
-Model::Model(const std::string& path)
-    : directory(std::filesystem::path(path).parent_path())
+Model::Model(
+    const std::string& path,
+    bool packTextures,
+    bool generateLods,
+    bool positionStream,
+    TextureStreamer* streamer,
+    JobSystem* jobs)
+    : directory(std::filesystem::path(path).parent_path()),
+      packTextures(packTextures),
+      generateLods(generateLods),
+      positionStream(positionStream),
+      streamer(streamer),
+      jobs(jobs)
 {
+  PROFILE_SCOPE("Model::load");
   Assimp::Importer importer;
-  const aiScene* scene = importer.ReadFile(
-      path,
-      aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenSmoothNormals |
-          aiProcess_CalcTangentSpace);
+  const aiScene* scene = nullptr;
+  {
+    PROFILE_SCOPE("Assimp::ReadFile");
+    scene = importer.ReadFile(
+        path,
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
+            aiProcess_FlipUVs | aiProcess_GenSmoothNormals |
+            aiProcess_CalcTangentSpace);
+  }
 
   if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ||
       scene->mRootNode == nullptr)
@@ -31,33 +64,101 @@ Model::Model(const std::string& path)
     throw std::runtime_error("ERROR::ASSIMP: "s + importer.GetErrorString());
   }
 
-  processNode(scene->mRootNode, scene);
+  std::vector<const aiMesh*> sceneMeshes;
+  processNode(scene->mRootNode, scene, sceneMeshes);
+
+  pendingMeshes.resize(sceneMeshes.size());
+  parallelFor(
+      sceneMeshes.size(),
+      [&](std::size_t i)
+      { pendingMeshes[i] = processMesh(sceneMeshes[i], scene); });
+
+  if (packTextures)
+    packPendingMeshes();
+  else
+    uploadPendingMeshes();
+
+  computeBindReport();
 }
 
 void Model::draw(const Shader& shader) const noexcept
 {
+  TextureBinder binder;
   for (auto& mesh : meshes)
-    mesh.draw(shader);
+    mesh.draw(shader, binder);
+}
+
+void Model::record(const Shader& shader, CommandBuffer& commands) const
+{
+  for (const auto& mesh : meshes)
+    mesh.record(shader, commands);
+}
+
+const std::vector<Mesh>& Model::getMeshes() const noexcept
+{
+  return meshes;
+}
+
+bool Model::hasPackedTextures() const noexcept
+{
+  return packTextures;
+}
+
+TextureBindReport Model::getTextureBindReport() const noexcept
+{
+  return bindReport;
 }
 
-void Model::processNode(aiNode* node, const aiScene* scene)
+void Model::processNode(
+    const aiNode* node,
+    const aiScene* scene,
+    std::vector<const aiMesh*>& sceneMeshes) const
 {
   for (unsigned int i = 0; i < node->mNumMeshes; i++)
   {
-    aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-    processMesh(mesh, scene);
+    sceneMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
   }
   for (unsigned int i = 0; i < node->mNumChildren; i++)
   {
-    processNode(node->mChildren[i], scene);
+    processNode(node->mChildren[i], scene, sceneMeshes);
   }
 }
 
-void Model::processMesh(aiMesh* mesh, const aiScene* scene)
+Model::PendingMesh Model::processMesh(
+    const aiMesh* mesh,
+    const aiScene* scene) const
+{
+  PROFILE_FUNCTION();
+  TextureRefVector textureRefs;
+
+  const aiMaterial* mat = scene->mMaterials[mesh->mMaterialIndex];
+  collectMaterialTexture(
+      mat, aiTextureType_DIFFUSE, Texture::Type::DIFFUSE, textureRefs);
+  collectMaterialTexture(
+      mat, aiTextureType_SPECULAR, Texture::Type::SPECULAR, textureRefs);
+
+  PendingMesh pending = { convertVertices(mesh),
+                          convertIndices(mesh),
+                          std::move(textureRefs),
+                          {},
+                          {} };
+  if (generateLods)
+    pending.lods =
+        MeshSimplifier::generateLods(pending.vertices, pending.indices);
+
+  std::size_t baseIndexCount =
+      pending.lods.empty() ? pending.indices.size()
+                           : pending.lods.front().indexCount;
+  pending.meshlets = MeshletBuilder::build(
+      pending.vertices, pending.indices, baseIndexCount);
+
+  return pending;
+}
+
+std::vector<Vertex> Model::convertVertices(const aiMesh* mesh)
 {
   std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-  TextureVector textures;
+  vertices.reserve(mesh->mNumVertices);
 
   for (unsigned int i = 0; i < mesh->mNumVertices; i++)
   {
@@ -80,48 +181,272 @@ void Model::processMesh(aiMesh* mesh, const aiScene* scene)
     vertices.push_back(vertex);
   }
 
+  return vertices;
+}
+
+std::vector<unsigned int> Model::convertIndices(const aiMesh* mesh)
+{
+  std::vector<unsigned int> indices;
+  indices.reserve(static_cast<std::size_t>(mesh->mNumFaces) * 3);
+
   for (unsigned int i = 0; i < mesh->mNumFaces; i++)
   {
-    aiFace face = mesh->mFaces[i];
+    const aiFace& face = mesh->mFaces[i];
     for (unsigned int j = 0; j < face.mNumIndices; j++)
       indices.push_back(face.mIndices[j]);
   }
 
-  if (mesh->mMaterialIndex >= 0)
-  {
-    aiMaterial* mat = scene->mMaterials[mesh->mMaterialIndex];
-
-    loadMaterialTexture(
-        mat, aiTextureType_DIFFUSE, Texture::Type::DIFFUSE, textures);
-    loadMaterialTexture(
-        mat, aiTextureType_SPECULAR, Texture::Type::SPECULAR, textures);
-  }
-
-  meshes.emplace_back(
-      std::move(vertices), std::move(indices), std::move(textures));
+  return indices;
 }
 
-void Model::loadMaterialTexture(
-    aiMaterial* mat,
+void Model::collectMaterialTexture(
+    const aiMaterial* mat,
     aiTextureType aiTexType,
     Texture::Type texType,
-    TextureVector& textures)
+    TextureRefVector& textureRefs) const
 {
   for (unsigned int i = 0; i < mat->GetTextureCount(aiTexType); i++)
   {
     aiString str;
     mat->GetTexture(aiTexType, i, &str);
+    textureRefs.emplace_back(str.C_Str(), texType);
+  }
+}
 
-    auto it = loadedTextures.find(str.C_Str());
-    if (it != loadedTextures.end())
+std::vector<std::string> Model::pendingTextureNames() const
+{
+  std::vector<std::string> names;
+  for (const auto& pending : pendingMeshes)
+  {
+    for (const auto& [name, type] : pending.textureRefs)
     {
-      textures.push_back(it->second);
+      if (std::find(names.begin(), names.end(), name) == names.end())
+        names.push_back(name);
     }
-    else
+  }
+
+  return names;
+}
+
+Model::ImageMap Model::decodeImages(
+    const std::vector<std::string>& names) const
+{
+  PROFILE_FUNCTION();
+  std::vector<std::optional<Image>> decoded(names.size());
+  parallelFor(
+      names.size(),
+      [&](std::size_t i) { decoded[i].emplace(directory / names[i]); });
+
+  ImageMap images;
+  for (std::size_t i = 0; i < names.size(); i++)
+    images.emplace(names[i], std::move(*decoded[i]));
+
+  return images;
+}
+
+std::shared_ptr<Texture> Model::loadTexture(
+    const std::string& name,
+    Texture::Type type,
+    const ImageMap& images)
+{
+  auto it = loadedTextures.find(name);
+  if (it != loadedTextures.end())
+    return it->second;
+
+  std::shared_ptr<Texture> texture =
+      streamer != nullptr
+          ? streamer->load(directory / name, type)
+          : std::make_shared<Texture>(images.at(name), type);
+  loadedTextures.insert({ name, texture });
+
+  return texture;
+}
+
+void Model::uploadPendingMeshes()
+{
+  PROFILE_FUNCTION();
+  ImageMap images;
+  if (streamer == nullptr)
+    images = decodeImages(pendingTextureNames());
+
+  for (auto& pending : pendingMeshes)
+  {
+    TextureVector textures;
+    for (const auto& [name, type] : pending.textureRefs)
+      textures.push_back(loadTexture(name, type, images));
+
+    meshes.emplace_back(
+        std::move(pending.vertices),
+        std::move(pending.indices),
+        std::move(textures),
+        std::vector<TextureLayer>(),
+        std::move(pending.lods),
+        std::move(pending.meshlets),
+        positionStream);
+  }
+  pendingMeshes.clear();
+}
+
+void Model::packPendingMeshes()
+{
+  PROFILE_FUNCTION();
+  using ImageKey = std::tuple<int, int, int>;
+
+  std::vector<std::string> names = pendingTextureNames();
+  ImageMap images = decodeImages(names);
+
+  std::map<ImageKey, std::vector<std::string>> groups;
+  for (const auto& name : names)
+  {
+    const Image& image = images.at(name);
+    groups[{ image.getWidth(), image.getHeight(), image.getChannels() }]
+        .push_back(name);
+  }
+
+  const std::size_t maxLayers = TextureArray::maxLayers();
+  std::unordered_map<std::string, std::pair<std::shared_ptr<TextureArray>, int>>
+      packed;
+  for (const auto& [key, group] : groups)
+  {
+    for (std::size_t first = 0; first < group.size(); first += maxLayers)
+    {
+      std::size_t last = std::min(group.size(), first + maxLayers);
+
+      std::vector<const Image*> layerImages;
+      for (std::size_t i = first; i < last; i++)
+        layerImages.push_back(&images.at(group[i]));
+
+      auto array = std::make_shared<TextureArray>(layerImages);
+      for (std::size_t i = first; i < last; i++)
+        packed[group[i]] = { array, static_cast<int>(i - first) };
+    }
+  }
+
+  for (auto& pending : pendingMeshes)
+  {
+    std::vector<TextureLayer> layers;
+    for (const auto& [name, type] : pending.textureRefs)
+    {
+      const auto& [array, layer] = packed.at(name);
+      layers.push_back({ array, layer, type });
+    }
+
+    meshes.emplace_back(
+        std::move(pending.vertices),
+        std::move(pending.indices),
+        TextureVector(),
+        std::move(layers),
+        std::move(pending.lods),
+        std::move(pending.meshlets),
+        positionStream);
+  }
+  pendingMeshes.clear();
+}
+
+void Model::parallelFor(
+    std::size_t count,
+    const std::function<void(std::size_t)>& body) const
+{
+  if (jobs == nullptr)
+  {
+    for (std::size_t i = 0; i < count; i++)
+      body(i);
+    return;
+  }
+
+  jobs->parallelFor(
+      count,
+      1,
+      [&body](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; i++)
+          body(i);
+      });
+}
+
+// Mirrors Mesh::recordMaterial: textures past MAX_MATERIAL_TEXTURES per type
+// are not bound, and each lands on its fixed Mesh::materialUnit.
+void Model::computeBindReport() noexcept
+{
+  bindReport = { 0, 0 };
+
+  std::array<unsigned int, 2 * Mesh::MAX_MATERIAL_TEXTURES> boundIds = {};
+  auto track = [&](Texture::Type type, unsigned int number, unsigned int id)
+  {
+    if (number > Mesh::MAX_MATERIAL_TEXTURES)
+      return;
+
+    unsigned int unit = Mesh::materialUnit(type, number);
+    if (boundIds[unit] != id)
     {
-      textures.emplace_back(
-          std::make_shared<Texture>(directory / str.C_Str(), texType));
-      loadedTextures.insert({ str.C_Str(), textures.back() });
+      boundIds[unit] = id;
+      bindReport.packedBinds++;
     }
+    bindReport.unpackedBinds++;
+  };
+
+  for (const auto& mesh : meshes)
+  {
+    unsigned int diffuseNr = 1, specularNr = 1;
+    auto next = [&](Texture::Type type)
+    {
+      return type == Texture::Type::DIFFUSE ? diffuseNr++ : specularNr++;
+    };
+
+    for (const auto& texture : mesh.getTextures())
+    {
+      Texture::Type type = texture->getType();
+      track(type, next(type), texture->getId());
+    }
+    for (const auto& layer : mesh.getTextureLayers())
+      track(layer.type, next(layer.type), layer.array->getId());
+  }
+}
+
+ModelBuilder& ModelBuilder::fromFile(const std::string& path)
+{
+  this->path = path;
+  return *this;
+}
+
+ModelBuilder& ModelBuilder::withTexturePacking(bool packTextures) noexcept
+{
+  this->packTextures = packTextures;
+  return *this;
+}
+
+ModelBuilder& ModelBuilder::withLodGeneration(bool generateLods) noexcept
+{
+  this->generateLods = generateLods;
+  return *this;
+}
+
+ModelBuilder& ModelBuilder::withPositionStream(bool positionStream) noexcept
+{
+  this->positionStream = positionStream;
+  return *this;
+}
+
+ModelBuilder& ModelBuilder::withTextureStreamer(
+    TextureStreamer& streamer) noexcept
+{
+  this->streamer = &streamer;
+  return *this;
+}
+
+ModelBuilder& ModelBuilder::withJobSystem(JobSystem& jobs) noexcept
+{
+  this->jobs = &jobs;
+  return *this;
+}
+
+Model ModelBuilder::build() const
+{
+  if (path.empty())
+  {
+    throw std::runtime_error("Invalid Argument: Model Path");
   }
+
+  return Model(
+      path, packTextures, generateLods, positionStream, streamer, jobs);
 }
@@ -0,0 +1,396 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "JobSystem.hpp"
+#include "Mesh.hpp"
+#include "Profiler.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+int levelSize(int size, std::size_t level)
+{
+  return ((size - 1) >> level) + 1;
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(int width, int height, JobSystem* jobs)
+    : width(width),
+      height(height),
+      tilesX(width / TILE_WIDTH),
+      tilesY(height / TILE_HEIGHT),
+      jobs(jobs)
+{
+  if (width <= 0 || height <= 0 || width % TILE_WIDTH != 0 ||
+      height % TILE_HEIGHT != 0)
+  {
+    throw std::runtime_error("ERROR::OCCLUSION_BUFFER::INVALID_SIZE");
+  }
+
+  bins.resize(static_cast<std::size_t>(tilesX * tilesY));
+  for (std::size_t level = 0;; level++)
+  {
+    int levelWidth = levelSize(width, level);
+    int levelHeight = levelSize(height, level);
+    levels.emplace_back(
+        static_cast<std::size_t>(levelWidth * levelHeight), 1.0F);
+    if (levelWidth == 1 && levelHeight == 1)
+      break;
+  }
+}
+
+void OcclusionBuffer::clear()
+{
+  triangles.clear();
+  for (auto& bin : bins)
+    bin.clear();
+  for (auto& level : levels)
+    std::fill(level.begin(), level.end(), 1.0F);
+}
+
+void OcclusionBuffer::addOccluder(
+    const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices,
+    std::size_t indexCount,
+    const glm::mat4& modelViewProjection)
+{
+  PROFILE_FUNCTION();
+  addTriangles(
+      [&vertices](unsigned int index) { return vertices[index].position; },
+      indices,
+      indexCount,
+      modelViewProjection);
+}
+
+void OcclusionBuffer::addOccluder(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<unsigned int>& indices,
+    std::size_t indexCount,
+    const glm::mat4& modelViewProjection)
+{
+  PROFILE_FUNCTION();
+  addTriangles(
+      [&positions](unsigned int index) { return positions[index]; },
+      indices,
+      indexCount,
+      modelViewProjection);
+}
+
+// Triangles that reach in front of the near plane are dropped rather than
+// clipped; losing occluder area only makes the test more conservative.
+template <typename PositionAt>
+void OcclusionBuffer::addTriangles(
+    PositionAt positionAt,
+    const std::vector<unsigned int>& indices,
+    std::size_t indexCount,
+    const glm::mat4& modelViewProjection)
+{
+  glm::vec2 scale(0.5F * static_cast<float>(width),
+                  0.5F * static_cast<float>(height));
+
+  for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+  {
+    ScreenTriangle triangle;
+    bool clipped = false;
+    for (std::size_t k = 0; k < 3; k++)
+    {
+      glm::vec4 clip =
+          modelViewProjection * glm::vec4(positionAt(indices[i + k]), 1.0F);
+      if (clip.w < NEAR_W || clip.z < -clip.w)
+      {
+        clipped = true;
+        break;
+      }
+
+      glm::vec3 ndc = glm::vec3(clip) / clip.w;
+      triangle.vertices[k] = glm::vec3(
+          (ndc.x + 1.0F) * scale.x,
+          (ndc.y + 1.0F) * scale.y,
+          ndc.z * 0.5F + 0.5F);
+    }
+    if (clipped)
+      continue;
+
+    auto& [a, b, c] = triangle.vertices;
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area == 0.0F)
+      continue;
+    if (area < 0.0F)
+      std::swap(b, c);
+
+    float minX = std::min({ a.x, b.x, c.x });
+    float maxX = std::max({ a.x, b.x, c.x });
+    float minY = std::min({ a.y, b.y, c.y });
+    float maxY = std::max({ a.y, b.y, c.y });
+
+    triangle.minX = std::max(static_cast<int>(std::ceil(minX - 0.5F)), 0);
+    triangle.maxX =
+        std::min(static_cast<int>(std::floor(maxX - 0.5F)), width - 1);
+    triangle.minY = std::max(static_cast<int>(std::ceil(minY - 0.5F)), 0);
+    triangle.maxY =
+        std::min(static_cast<int>(std::floor(maxY - 0.5F)), height - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+      continue;
+
+    auto index = static_cast<unsigned int>(triangles.size());
+    triangles.push_back(triangle);
+    for (int ty = triangle.minY / TILE_HEIGHT;
+         ty <= triangle.maxY / TILE_HEIGHT;
+         ty++)
+    {
+      for (int tx = triangle.minX / TILE_WIDTH;
+           tx <= triangle.maxX / TILE_WIDTH;
+           tx++)
+      {
+        bins[static_cast<std::size_t>(ty * tilesX + tx)].push_back(index);
+      }
+    }
+  }
+}
+
+// Tiles own disjoint pixels, so they rasterize in parallel without locking.
+void OcclusionBuffer::finish()
+{
+  PROFILE_FUNCTION();
+  auto rasterize = [this](std::size_t begin, std::size_t end)
+  {
+    for (std::size_t tile = begin; tile < end; tile++)
+      rasterizeTile(tile);
+  };
+
+  if (jobs == nullptr)
+    rasterize(0, bins.size());
+  else
+    jobs->parallelFor(bins.size(), 1, rasterize);
+
+  buildHierarchy();
+}
+
+// Bounds are replaced by their screen rectangle and nearest depth, which is
+// compared against the farthest occluder depth at a pyramid level where the
+// rectangle covers at most MAX_TEST_TEXELS texels per axis.
+bool OcclusionBuffer::isVisible(
+    const BoundingSphere& bounds,
+    const glm::mat4& modelViewProjection) const noexcept
+{
+  glm::vec2 minScreen(INFINITY);
+  glm::vec2 maxScreen(-INFINITY);
+  float minDepth = INFINITY;
+  for (int corner = 0; corner < 8; corner++)
+  {
+    glm::vec3 offset((corner & 1) ? 1.0F : -1.0F,
+                     (corner & 2) ? 1.0F : -1.0F,
+                     (corner & 4) ? 1.0F : -1.0F);
+    glm::vec4 clip =
+        modelViewProjection *
+        glm::vec4(bounds.center + offset * bounds.radius, 1.0F);
+    if (clip.w < NEAR_W || clip.z < -clip.w)
+      return true;
+
+    glm::vec3 ndc = glm::vec3(clip) / clip.w;
+    minScreen = glm::min(minScreen, glm::vec2(ndc));
+    maxScreen = glm::max(maxScreen, glm::vec2(ndc));
+    minDepth = std::min(minDepth, ndc.z * 0.5F + 0.5F);
+  }
+
+  auto toPixel = [](float ndc, int size)
+  {
+    int pixel = static_cast<int>(
+        std::floor((ndc + 1.0F) * 0.5F * static_cast<float>(size)));
+    return std::clamp(pixel, 0, size - 1);
+  };
+  int minX = toPixel(minScreen.x, width);
+  int maxX = toPixel(maxScreen.x, width);
+  int minY = toPixel(minScreen.y, height);
+  int maxY = toPixel(maxScreen.y, height);
+
+  std::size_t level = 0;
+  while (level + 1 < levels.size() &&
+         ((maxX >> level) - (minX >> level) >= MAX_TEST_TEXELS ||
+          (maxY >> level) - (minY >> level) >= MAX_TEST_TEXELS))
+  {
+    level++;
+  }
+
+  int levelWidth = levelSize(width, level);
+  const std::vector<float>& depths = levels[level];
+  for (int y = minY >> level; y <= maxY >> level; y++)
+  {
+    for (int x = minX >> level; x <= maxX >> level; x++)
+    {
+      if (depths[static_cast<std::size_t>(y * levelWidth + x)] >= minDepth)
+        return true;
+    }
+  }
+  return false;
+}
+
+int OcclusionBuffer::getWidth() const noexcept
+{
+  return width;
+}
+
+int OcclusionBuffer::getHeight() const noexcept
+{
+  return height;
+}
+
+float OcclusionBuffer::getDepth(
+    int x,
+    int y,
+    std::size_t level) const noexcept
+{
+  return levels[level][static_cast<std::size_t>(
+      y * levelSize(width, level) + x)];
+}
+
+std::size_t OcclusionBuffer::getLevelCount() const noexcept
+{
+  return levels.size();
+}
+
+std::size_t OcclusionBuffer::getTriangleCount() const noexcept
+{
+  return triangles.size();
+}
+
+// Edge functions and depth are planes in screen space, evaluated four
+// pixels at a time; covered pixels keep the nearest depth.
+void OcclusionBuffer::rasterizeTile(std::size_t tile)
+{
+  int tileX = static_cast<int>(tile) % tilesX * TILE_WIDTH;
+  int tileY = static_cast<int>(tile) / tilesX * TILE_HEIGHT;
+  std::vector<float>& depths = levels.front();
+
+  for (unsigned int index : bins[tile])
+  {
+    const ScreenTriangle& triangle = triangles[index];
+    const auto& [a, b, c] = triangle.vertices;
+
+    std::array<glm::vec3, 3> edges;
+    const std::array<std::pair<glm::vec3, glm::vec3>, 3> ends = {
+      { { a, b }, { b, c }, { c, a } }
+    };
+    for (std::size_t e = 0; e < 3; e++)
+    {
+      const auto& [from, to] = ends[e];
+      float stepX = from.y - to.y;
+      float stepY = to.x - from.x;
+      edges[e] = glm::vec3(stepX, stepY, -(stepX * from.x + stepY * from.y));
+    }
+
+    // Barycentric weights of b and c are the edges opposite them.
+    float area = edges[0].z + edges[0].x * c.x + edges[0].y * c.y;
+    glm::vec3 depthPlane =
+        (edges[2] * (b.z - a.z) + edges[0] * (c.z - a.z)) / area;
+    depthPlane.z += a.z;
+
+    int minX = std::max(triangle.minX, tileX) & ~3;
+    int maxX = std::min(triangle.maxX, tileX + TILE_WIDTH - 1);
+    int minY = std::max(triangle.minY, tileY);
+    int maxY = std::min(triangle.maxY, tileY + TILE_HEIGHT - 1);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+      float py = static_cast<float>(y) + 0.5F;
+      float* row = depths.data() + static_cast<std::size_t>(y * width);
+
+#if defined(__SSE2__)
+      __m128 rowEdges[3];
+      __m128 stepEdges[3];
+      for (std::size_t e = 0; e < 3; e++)
+      {
+        rowEdges[e] = _mm_set1_ps(edges[e].y * py + edges[e].z);
+        stepEdges[e] = _mm_set1_ps(edges[e].x);
+      }
+      __m128 rowDepth = _mm_set1_ps(depthPlane.y * py + depthPlane.z);
+      __m128 stepDepth = _mm_set1_ps(depthPlane.x);
+      __m128 zero = _mm_setzero_ps();
+
+      for (int x = minX; x <= maxX; x += 4)
+      {
+        float px = static_cast<float>(x) + 0.5F;
+        __m128 pxs = _mm_add_ps(
+            _mm_set1_ps(px), _mm_set_ps(3.0F, 2.0F, 1.0F, 0.0F));
+
+        __m128 inside = _mm_cmpge_ps(
+            _mm_add_ps(_mm_mul_ps(stepEdges[0], pxs), rowEdges[0]), zero);
+        for (std::size_t e = 1; e < 3; e++)
+        {
+          inside = _mm_and_ps(
+              inside,
+              _mm_cmpge_ps(
+                  _mm_add_ps(_mm_mul_ps(stepEdges[e], pxs), rowEdges[e]),
+                  zero));
+        }
+        if (_mm_movemask_ps(inside) == 0)
+          continue;
+
+        __m128 depth = _mm_add_ps(_mm_mul_ps(stepDepth, pxs), rowDepth);
+        __m128 stored = _mm_loadu_ps(row + x);
+        __m128 nearest = _mm_min_ps(stored, depth);
+        _mm_storeu_ps(
+            row + x,
+            _mm_or_ps(
+                _mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+      }
+#else
+      for (int x = minX; x <= maxX; x++)
+      {
+        float px = static_cast<float>(x) + 0.5F;
+        bool inside = true;
+        for (const auto& edge : edges)
+          inside = inside && edge.x * px + edge.y * py + edge.z >= 0.0F;
+        if (!inside)
+          continue;
+
+        float depth = depthPlane.x * px + depthPlane.y * py + depthPlane.z;
+        row[x] = std::min(row[x], depth);
+      }
+#endif
+    }
+  }
+}
+
+void OcclusionBuffer::buildHierarchy()
+{
+  PROFILE_FUNCTION();
+  for (std::size_t level = 1; level < levels.size(); level++)
+  {
+    int sourceWidth = levelSize(width, level - 1);
+    int sourceHeight = levelSize(height, level - 1);
+    int levelWidth = levelSize(width, level);
+    int levelHeight = levelSize(height, level);
+    const std::vector<float>& source = levels[level - 1];
+
+    for (int y = 0; y < levelHeight; y++)
+    {
+      for (int x = 0; x < levelWidth; x++)
+      {
+        float farthest = 0.0F;
+        for (int sy = 2 * y; sy < std::min(2 * y + 2, sourceHeight); sy++)
+        {
+          for (int sx = 2 * x; sx < std::min(2 * x + 2, sourceWidth); sx++)
+          {
+            farthest = std::max(
+                farthest,
+                source[static_cast<std::size_t>(sy * sourceWidth + sx)]);
+          }
+        }
+        levels[level][static_cast<std::size_t>(y * levelWidth + x)] = farthest;
+      }
+    }
+  }
+}
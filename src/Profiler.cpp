@@ -0,0 +1,260 @@
+#include "Profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+std::mutex Profiler::registryMutex;
+std::vector<std::unique_ptr<ProfileBuffer>> Profiler::buffers;
+std::vector<ProfileBuffer*> Profiler::freeBuffers;
+std::vector<Profiler::RetiredTrack> Profiler::retiredTracks;
+std::uint32_t Profiler::nextThreadId = 0;
+std::uint64_t Profiler::lastFrameNs = Profiler::now();
+
+ProfileBuffer::ProfileBuffer(std::uint32_t threadId) noexcept
+    : threadId(threadId)
+{ }
+
+// Each slot is a small seqlock: the sequence is odd while the owning thread
+// rewrites it and 2 * (index + 1) once event index is complete, so snapshot
+// can run concurrently and skip slots that wrapped while it was reading.
+void ProfileBuffer::push(const ProfileEvent& event) noexcept
+{
+  std::uint64_t index = head.load(std::memory_order_relaxed);
+  Slot& slot = events[index % CAPACITY];
+
+  slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(event.name, std::memory_order_relaxed);
+  slot.startNs.store(event.startNs, std::memory_order_relaxed);
+  slot.endNs.store(event.endNs, std::memory_order_relaxed);
+  slot.sequence.store(index * 2 + 2, std::memory_order_release);
+
+  head.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ProfileEvent> ProfileBuffer::snapshot() const
+{
+  std::uint64_t end = head.load(std::memory_order_acquire);
+  std::uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+
+  std::vector<ProfileEvent> result;
+  result.reserve(end - begin);
+  for (std::uint64_t i = begin; i < end; i++)
+  {
+    const Slot& slot = events[i % CAPACITY];
+
+    std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != i * 2 + 2)
+      continue;
+
+    ProfileEvent event = { slot.name.load(std::memory_order_relaxed),
+                           slot.startNs.load(std::memory_order_relaxed),
+                           slot.endNs.load(std::memory_order_relaxed) };
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    result.push_back(event);
+  }
+
+  return result;
+}
+
+std::uint32_t ProfileBuffer::getThreadId() const noexcept
+{
+  return threadId;
+}
+
+const char* ProfileBuffer::getThreadName() const noexcept
+{
+  return threadName.load(std::memory_order_relaxed);
+}
+
+void ProfileBuffer::setThreadName(const char* name) noexcept
+{
+  threadName.store(name, std::memory_order_relaxed);
+}
+
+// Only called with the registry locked and no owning thread, so neither
+// push nor snapshot can observe the buffer mid-reset.
+void ProfileBuffer::reset(std::uint32_t threadId) noexcept
+{
+  head.store(0, std::memory_order_relaxed);
+  this->threadId = threadId;
+  threadName.store(nullptr, std::memory_order_relaxed);
+}
+
+std::uint64_t Profiler::now() noexcept
+{
+  using namespace std::chrono;
+  static const steady_clock::time_point epoch = steady_clock::now();
+  return duration_cast<nanoseconds>(steady_clock::now() - epoch).count();
+}
+
+// Returns the thread's buffer to the free list when the thread exits, so
+// short-lived threads reuse an existing track instead of each keeping a
+// full ring alive for the rest of the process.
+struct Profiler::ThreadBufferHandle
+{
+  ProfileBuffer* buffer = nullptr;
+
+  ~ThreadBufferHandle() noexcept
+  {
+    if (buffer != nullptr)
+      Profiler::releaseBuffer(buffer);
+  }
+};
+
+ProfileBuffer& Profiler::threadBuffer()
+{
+  thread_local ThreadBufferHandle handle;
+  if (handle.buffer == nullptr)
+    handle.buffer = acquireBuffer();
+  return *handle.buffer;
+}
+
+ProfileBuffer& Profiler::createTrack(const char* name)
+{
+  std::lock_guard lock(registryMutex);
+  buffers.push_back(std::make_unique<ProfileBuffer>(nextThreadId++));
+  buffers.back()->setThreadName(name);
+  return *buffers.back();
+}
+
+void Profiler::record(
+    const char* name,
+    std::uint64_t startNs,
+    std::uint64_t endNs)
+{
+  threadBuffer().push({ name, startNs, endNs });
+}
+
+void Profiler::setThreadName(const char* name)
+{
+  threadBuffer().setThreadName(name);
+}
+
+void Profiler::markFrame()
+{
+  std::uint64_t nowNs = now();
+  record("Frame", lastFrameNs, nowNs);
+  lastFrameNs = nowNs;
+}
+
+static void writeJsonString(std::ofstream& out, const char* str)
+{
+  out << '"';
+  for (; *str != '\0'; str++)
+  {
+    if (*str == '"' || *str == '\\')
+      out << '\\';
+    out << *str;
+  }
+  out << '"';
+}
+
+void Profiler::exportChromeTrace(const std::string& path)
+{
+  std::ofstream out(path);
+  if (!out)
+  {
+    throw std::runtime_error("ERROR::PROFILER::EXPORT_FAILED: " + path);
+  }
+
+  std::lock_guard lock(registryMutex);
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&]()
+  {
+    if (!first)
+      out << ",\n";
+    first = false;
+  };
+
+  auto writeTrack =
+      [&](std::uint32_t threadId,
+          const char* threadName,
+          const std::vector<ProfileEvent>& events)
+  {
+    if (threadName != nullptr)
+    {
+      separator();
+      out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+          << threadId << ",\"args\":{\"name\":";
+      writeJsonString(out, threadName);
+      out << "}}";
+    }
+
+    for (const auto& event : events)
+    {
+      separator();
+      out << "{\"ph\":\"X\",\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"pid\":1,\"tid\":" << threadId
+          << ",\"ts\":" << event.startNs / 1000.0
+          << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0 << '}';
+    }
+  };
+
+  for (const auto& track : retiredTracks)
+    writeTrack(track.threadId, track.threadName, track.events);
+  for (const auto& buffer : buffers)
+  {
+    writeTrack(
+        buffer->getThreadId(), buffer->getThreadName(), buffer->snapshot());
+  }
+
+  out << "]}\n";
+}
+
+// Before a buffer is recycled, the exited thread's events are copied out
+// under its own tid and name; the buffer then starts empty under a fresh tid.
+ProfileBuffer* Profiler::acquireBuffer()
+{
+  std::lock_guard lock(registryMutex);
+  if (!freeBuffers.empty())
+  {
+    ProfileBuffer* buffer = freeBuffers.back();
+    retiredTracks.push_back({ buffer->getThreadId(),
+                              buffer->getThreadName(),
+                              buffer->snapshot() });
+    freeBuffers.pop_back();
+    buffer->reset(nextThreadId++);
+    return buffer;
+  }
+
+  buffers.push_back(std::make_unique<ProfileBuffer>(nextThreadId++));
+  // Reserved here so releasing at thread exit never allocates.
+  freeBuffers.reserve(buffers.size());
+  return buffers.back().get();
+}
+
+void Profiler::releaseBuffer(ProfileBuffer* buffer) noexcept
+{
+  std::lock_guard lock(registryMutex);
+  freeBuffers.push_back(buffer);
+}
+
+// The buffer is fetched on entry, where a first-use allocation may throw,
+// so the noexcept destructor only pushes.
+ProfileScope::ProfileScope(const char* name)
+    : buffer(Profiler::threadBuffer()),
+      name(name),
+      startNs(Profiler::now())
+{ }
+
+ProfileScope::~ProfileScope() noexcept
+{
+  buffer.push({ name, startNs, Profiler::now() });
+}
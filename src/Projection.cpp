@@ -1,23 +1,29 @@
 #include "Projection.hpp"
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <stdexcept>
 
+#include "Generation.hpp"
+
 Projection::Projection(
     float fov,
     float minFov,
     float maxFov,
     float aspectRatio,
     float near,
-    float far) noexcept
+    float far,
+    bool reverseZ) noexcept
     : minFov(minFov),
       maxFov(maxFov),
       aspectRatio(aspectRatio),
       near(near),
-      far(far)
+      far(far),
+      reverseZ(reverseZ),
+      generation(Generation::next())
 {
-  setFov(fov);
+  this->fov = glm::clamp(fov, minFov, maxFov);
 }
 
 void Projection::setFovRange(float min, float max) noexcept
@@ -29,19 +35,64 @@ void Projection::setFovRange(float min, float max) noexcept
 
 void Projection::setFov(float fov) noexcept
 {
-  this->fov = glm::clamp(fov, minFov, maxFov);
+  fov = glm::clamp(fov, minFov, maxFov);
+  if (fov == this->fov)
+    return;
+
+  this->fov = fov;
+  generation = Generation::next();
 }
 
 void Projection::updateFov(float yoffset) noexcept
 {
-  fov -= yoffset;
-  setFov(fov);
+  setFov(fov - yoffset);
+}
+
+const glm::mat4& Projection::getProjectionMatrix() const
+{
+  _updateMatrices();
+  return projection;
+}
+
+const glm::mat4& Projection::getInverseProjectionMatrix() const
+{
+  _updateMatrices();
+  return inverseProjection;
+}
+
+bool Projection::isReverseZ() const noexcept
+{
+  return reverseZ;
 }
 
-glm::mat4 Projection::getProjectionMatrix() const
+std::uint64_t Projection::getGeneration() const noexcept
 {
-  glm::mat4 mat = glm::perspective(glm::radians(fov), aspectRatio, near, far);
-  return mat;
+  return generation;
+}
+
+// The reverse-Z matrix has no far plane and targets a [0, 1] clip depth
+// range (glClipControl): the near plane maps to 1 and depth falls towards 0
+// at infinity, which spreads a float depth buffer's precision evenly.
+void Projection::_updateMatrices() const
+{
+  if (matrixGeneration == generation)
+    return;
+
+  if (!reverseZ)
+  {
+    projection = glm::perspective(glm::radians(fov), aspectRatio, near, far);
+  }
+  else
+  {
+    float focal = 1.0F / glm::tan(glm::radians(fov) * 0.5F);
+    projection = glm::mat4(0.0F);
+    projection[0][0] = focal / aspectRatio;
+    projection[1][1] = focal;
+    projection[2][3] = -1.0F;
+    projection[3][2] = near;
+  }
+  inverseProjection = glm::inverse(projection);
+  matrixGeneration = generation;
 }
 
 ProjectionBuilder& ProjectionBuilder::withFov(float fov) noexcept
@@ -73,6 +124,12 @@ ProjectionBuilder& ProjectionBuilder::withZRange(float near, float far) noexcept
   return *this;
 }
 
+ProjectionBuilder& ProjectionBuilder::withReverseZ(bool reverseZ) noexcept
+{
+  this->reverseZ = reverseZ;
+  return *this;
+}
+
 Projection ProjectionBuilder::build() const
 {
   if (minFov >= maxFov)
@@ -88,5 +145,5 @@ Projection ProjectionBuilder::build() const
     throw std::runtime_error("Invalid Argument: Aspect Ratio");
   }
 
-  return Projection(fov, minFov, maxFov, aspectRatio, near, far);
+  return Projection(fov, minFov, maxFov, aspectRatio, near, far, reverseZ);
 }
@@ -0,0 +1,1140 @@
+#include "Renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Camera.hpp"
+#include "CascadedShadowMap.hpp"
+#include "CommandBuffer.hpp"
+#include "Frustum.hpp"
+#include "GBuffer.hpp"
+#include "GLExtensions.hpp"
+#include "GpuCuller.hpp"
+#include "GpuProfiler.hpp"
+#include "JobSystem.hpp"
+#include "LightGrid.hpp"
+#include "Mesh.hpp"
+#include "Model.hpp"
+#include "Profiler.hpp"
+#include "Projection.hpp"
+#include "RingBuffer.hpp"
+#include "Shader.hpp"
+#include "glad/glad.h"
+
+namespace
+{
+struct FrameUniforms
+{
+  glm::mat4 projection;
+  glm::mat4 view;
+};
+
+struct ObjectUniforms
+{
+  glm::mat4 model;
+  glm::vec4 materialLayers;
+};
+
+// Turns a reverse-Z infinite projection into the forward-Z one with the same
+// near plane and the given, possibly infinite, far plane. Culling, light
+// binning and shadow fitting all work in forward depth.
+glm::mat4 forwardProjection(const glm::mat4& projection, float far)
+{
+  float near = projection[3][2];
+  glm::mat4 result = projection;
+  if (far == std::numeric_limits<float>::infinity())
+  {
+    result[2][2] = -1.0F;
+    result[3][2] = -2.0F * near;
+  }
+  else
+  {
+    result[2][2] = -(far + near) / (far - near);
+    result[3][2] = -2.0F * far * near / (far - near);
+  }
+  return result;
+}
+}  // namespace
+
+Renderer::Renderer(
+    const std::string& shaderDirectory,
+    bool packedTextures,
+    glm::vec4 clearColor,
+    int width,
+    int height,
+    JobSystem* jobs,
+    bool gpuCulling,
+    bool shadows,
+    bool deferredShading,
+    bool reverseZ)
+    : sceneShader(
+          shaderDirectory +
+              (shadows || deferredShading ? "/vertex6.glsl" : "/vertex2.glsl"),
+          shaderDirectory + (shadows || deferredShading ? "/fragment6.glsl"
+                             : packedTextures           ? "/fragment3.glsl"
+                                                        : "/fragment2.glsl")),
+      depthShader(
+          shaderDirectory + "/vertex5.glsl",
+          shaderDirectory + "/fragment5.glsl"),
+      dynamicUniforms(GL_UNIFORM_BUFFER, DYNAMIC_FRAME_CAPACITY),
+      jobs(jobs),
+      stats({ 0, 0, 0, 0, 0 }),
+      recordedStats({ 0, 0, 0, 0, 0 }),
+      occlusionBuffer(
+          OcclusionBuffer::DEFAULT_WIDTH,
+          OcclusionBuffer::DEFAULT_HEIGHT,
+          jobs),
+      light(RendererBuilder::DEFAULT_LIGHT),
+      clearColor(clearColor)
+{
+  std::size_t alignment = dynamicUniforms.getAlignment();
+  objectStride =
+      (sizeof(ObjectUniforms) + alignment - 1) / alignment * alignment;
+
+  sceneShader.setUniformBlockBinding("Frame", FRAME_BINDING);
+  sceneShader.setUniformBlockBinding("Object", OBJECT_BINDING);
+  depthShader.setUniformBlockBinding("Frame", FRAME_BINDING);
+  depthShader.setUniformBlockBinding("Object", OBJECT_BINDING);
+  Mesh::setMaterialSamplers(sceneShader);
+
+  this->reverseZ = reverseZ && GLExtensions::hasClipControl();
+
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_CULL_FACE);
+  resize(width, height);
+
+  auto setLightSamplers = [](const Shader& shader)
+  {
+    shader.bind();
+    shader.setInt("shadowMap", static_cast<int>(SHADOW_UNIT));
+    shader.setInt("lights", static_cast<int>(LIGHT_UNIT));
+    shader.setInt("lightTiles", static_cast<int>(TILE_UNIT));
+    shader.unbind();
+  };
+
+  if (shadows)
+    shadowMap = std::make_unique<CascadedShadowMap>();
+
+  if (shadows || deferredShading)
+  {
+    lightGrid = std::make_unique<LightGrid>(width, height);
+    setLightSamplers(sceneShader);
+    sceneShader.bind();
+    sceneShader.setFloat("shininess", SHININESS);
+    sceneShader.unbind();
+  }
+
+  if (deferredShading)
+  {
+    gBuffer = std::make_unique<GBuffer>(width, height, this->reverseZ);
+
+    gBufferShader = std::make_unique<Shader>(
+        shaderDirectory + "/vertex6.glsl", shaderDirectory + "/fragment7.glsl");
+    gBufferShader->setUniformBlockBinding("Frame", FRAME_BINDING);
+    gBufferShader->setUniformBlockBinding("Object", OBJECT_BINDING);
+    Mesh::setMaterialSamplers(*gBufferShader);
+    gBufferShader->bind();
+    gBufferShader->setFloat("shininess", SHININESS);
+    gBufferShader->unbind();
+
+    lightingShader = std::make_unique<Shader>(
+        shaderDirectory + "/vertex4.glsl", shaderDirectory + "/fragment8.glsl");
+    lightingShader->setUniformBlockBinding("Frame", FRAME_BINDING);
+    setLightSamplers(*lightingShader);
+    lightingShader->bind();
+    lightingShader->setInt("gAlbedoSpecular", static_cast<int>(GBUFFER_UNIT));
+    lightingShader->setInt(
+        "gNormalShininess", static_cast<int>(GBUFFER_UNIT + 1));
+    lightingShader->setInt("gDepth", static_cast<int>(GBUFFER_UNIT + 2));
+    lightingShader->setBool("reverseZ", this->reverseZ);
+    lightingShader->unbind();
+
+    shadingMode = ShadingMode::DEFERRED;
+  }
+
+  if (gpuCulling && GpuCuller::isSupported(dynamicUniforms.getSize()))
+  {
+    gpuCuller = std::make_unique<GpuCuller>(
+        shaderDirectory,
+        dynamicUniforms.getId(),
+        width,
+        height,
+        this->reverseZ);
+  }
+}
+
+void Renderer::addInstance(
+    const Model& model,
+    const glm::mat4& transform,
+    bool occluder)
+{
+  instances.push_back({ &model, transform, occluder });
+}
+
+void Renderer::clearInstances() noexcept
+{
+  instances.clear();
+}
+
+void Renderer::invalidateCommands() noexcept
+{
+  commandsValid = false;
+}
+
+void Renderer::setLodSelection(bool enabled) noexcept
+{
+  lodSelection = enabled;
+  invalidateCulling();
+}
+
+void Renderer::setMeshletCulling(bool enabled) noexcept
+{
+  if (meshletCulling != enabled)
+    commandsValid = false;
+  meshletCulling = enabled;
+}
+
+void Renderer::setOcclusionCulling(bool enabled) noexcept
+{
+  occlusionCulling = enabled;
+  invalidateCulling();
+}
+
+void Renderer::setDepthPrepass(bool enabled) noexcept
+{
+  depthPrepass = enabled;
+}
+
+// Meshlet normal cones only reject back-facing clusters, so they are tested
+// only while back faces are culled; two-sided geometry turns both off.
+void Renderer::setBackFaceCulling(bool enabled) noexcept
+{
+  backFaceCulling = enabled;
+  invalidateCulling();
+}
+
+void Renderer::setDirectionalLight(const DirectionalLight& light) noexcept
+{
+  this->light = light;
+}
+
+void Renderer::addPointLight(const PointLight& light)
+{
+  pointLights.push_back(light);
+}
+
+void Renderer::clearPointLights() noexcept
+{
+  pointLights.clear();
+}
+
+// Switching re-records the commands against the other path's shader.
+void Renderer::setShadingMode(ShadingMode mode) noexcept
+{
+  if (mode == ShadingMode::DEFERRED && gBuffer == nullptr)
+    return;
+  if (shadingMode != mode)
+    commandsValid = false;
+  shadingMode = mode;
+}
+
+void Renderer::resize(int width, int height)
+{
+  this->width = width;
+  this->height = height;
+  glViewport(0, 0, width, height);
+  invalidateCulling();
+
+  if (gpuCuller != nullptr)
+    gpuCuller->resize(width, height);
+  if (gBuffer != nullptr)
+    gBuffer->resize(width, height);
+  if (lightGrid != nullptr)
+    lightGrid->resize(width, height);
+}
+
+void Renderer::render(const Camera& camera, const Projection& projection)
+{
+  render(
+      camera.getViewMatrix(),
+      projection.getProjectionMatrix(),
+      instances,
+      camera.getGeneration(),
+      projection.getGeneration());
+}
+
+// Generations identify the camera and projection state behind view and
+// projection, 0 meaning unknown. When both match the previous frame and the
+// scene is unchanged, LOD selection and CPU culling results are reused.
+void Renderer::render(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const std::vector<RenderInstance>& instances,
+    std::uint64_t viewGeneration,
+    std::uint64_t projectionGeneration)
+{
+  PROFILE_SCOPE("Renderer::render");
+  gpuProfiler.beginFrame();
+
+  glm::mat4 cullProjection = projection;
+  if (reverseZ)
+  {
+    cullProjection =
+        forwardProjection(projection, std::numeric_limits<float>::infinity());
+    setDepthConvention(true);
+  }
+
+  if (backFaceCulling)
+    glEnable(GL_CULL_FACE);
+  else
+    glDisable(GL_CULL_FACE);
+
+  glClearColor(clearColor.x, clearColor.y, clearColor.z, clearColor.w);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  GpuProfileScope gpuScope(gpuProfiler, "Scene");
+
+  bool reuseCulling = viewGeneration != 0 &&
+                      viewGeneration == culledViewGeneration &&
+                      projectionGeneration == culledProjectionGeneration &&
+                      commandsValid && instances == recordedInstances;
+  culledViewGeneration = viewGeneration;
+  culledProjectionGeneration = projectionGeneration;
+
+  if (!reuseCulling)
+    selectLods(view, projection, instances);
+
+  if (!commandsValid || instances != recordedInstances ||
+      lodLevels != recordedLodLevels)
+  {
+    record(instances);
+  }
+  if (gpuCuller == nullptr && !reuseCulling)
+  {
+    renderOccluders(view, cullProjection, instances);
+    cull(view, cullProjection, instances);
+  }
+
+  dynamicUniforms.beginFrame();
+
+  FrameUniforms frameUniforms = { projection, view };
+  RingAllocation frameData = dynamicUniforms.allocate(sizeof(FrameUniforms));
+  std::memcpy(frameData.data, &frameUniforms, sizeof(FrameUniforms));
+
+  // One Object entry per mesh of every instance, in the order lodLevels and
+  // record() walk them.
+  RingAllocation objectData =
+      dynamicUniforms.allocate(lodLevels.size() * objectStride);
+  std::size_t object = 0;
+  for (const auto& instance : instances)
+  {
+    for (const auto& mesh : instance.model->getMeshes())
+    {
+      ObjectUniforms objectUniforms = { instance.transform,
+                                        mesh.getMaterialLayers() };
+      std::memcpy(
+          objectData.data + object++ * objectStride,
+          &objectUniforms,
+          sizeof(ObjectUniforms));
+    }
+  }
+
+  if (shadowMap != nullptr)
+  {
+    updateShadows(
+        view,
+        reverseZ ? forwardProjection(projection, SHADOW_DISTANCE) : projection,
+        instances);
+  }
+
+  dynamicUniforms.flush();
+
+  bool deferred = shadingMode == ShadingMode::DEFERRED;
+  if (shadowMap != nullptr)
+    drawShadows(objectData.offset);
+  if (lightGrid != nullptr)
+  {
+    lightGrid->build(pointLights, view, cullProjection);
+    setLightUniforms(deferred ? *lightingShader : sceneShader, view);
+  }
+
+  // The lighting pass skips texels left at the far plane, so the G-buffer's
+  // colour attachments need no clear.
+  GLint framebuffer = 0;
+  if (deferred)
+  {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+    gBuffer->bind();
+    glClear(GL_DEPTH_BUFFER_BIT);
+  }
+
+  glBindBufferRange(
+      GL_UNIFORM_BUFFER,
+      FRAME_BINDING,
+      dynamicUniforms.getId(),
+      frameData.offset,
+      sizeof(FrameUniforms));
+  {
+    GpuProfileScope passScope(
+        gpuProfiler, depthPrepass ? "DepthPrepass" : "Shading");
+    if (gpuCuller != nullptr)
+      drawGpuCulled(view, cullProjection, objectData.offset, depthPrepass);
+    else
+      executeCommands(objectData.offset, &culledRanges, depthPrepass);
+  }
+
+  if (depthPrepass)
+  {
+    GpuProfileScope shadingScope(gpuProfiler, "Shading");
+    glDepthFunc(GL_EQUAL);
+    glDepthMask(GL_FALSE);
+
+    drawShading(objectData.offset);
+
+    glDepthMask(GL_TRUE);
+    glDepthFunc(reverseZ ? GL_GREATER : GL_LESS);
+  }
+
+  if (deferred)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned int>(framebuffer));
+    GpuProfileScope lightingScope(gpuProfiler, "Lighting");
+    drawLighting(view, projection);
+  }
+
+  dynamicUniforms.endFrame();
+
+  stats = recordedStats;
+  for (const auto& drawStats : culledStats)
+  {
+    stats.drawCalls += drawStats.drawCalls;
+    stats.triangles += drawStats.triangles;
+    stats.visibleMeshlets += drawStats.visibleMeshlets;
+    stats.totalMeshlets += drawStats.totalMeshlets;
+    stats.occludedMeshlets += drawStats.occludedMeshlets;
+  }
+}
+
+const RenderStats& Renderer::getStats() const noexcept
+{
+  return stats;
+}
+
+const CommandBuffer& Renderer::getCommands() const noexcept
+{
+  return commands;
+}
+
+const OcclusionBuffer& Renderer::getOcclusionBuffer() const noexcept
+{
+  return occlusionBuffer;
+}
+
+bool Renderer::hasGpuCulling() const noexcept
+{
+  return gpuCuller != nullptr;
+}
+
+bool Renderer::hasShadows() const noexcept
+{
+  return shadowMap != nullptr;
+}
+
+bool Renderer::hasDeferredShading() const noexcept
+{
+  return gBuffer != nullptr;
+}
+
+bool Renderer::hasReverseZ() const noexcept
+{
+  return reverseZ;
+}
+
+ShadingMode Renderer::getShadingMode() const noexcept
+{
+  return shadingMode;
+}
+
+GpuProfiler& Renderer::getGpuProfiler() noexcept
+{
+  return gpuProfiler;
+}
+
+void Renderer::invalidateCulling() noexcept
+{
+  culledViewGeneration = 0;
+}
+
+// Picks, per mesh, the coarsest LOD whose simplification error projects to
+// less than LOD_PIXEL_ERROR pixels. projection[1][1] is cot(fov / 2), so
+// this scales with the projection's field of view.
+void Renderer::selectLods(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const std::vector<RenderInstance>& instances)
+{
+  PROFILE_FUNCTION();
+  lodLevels.clear();
+
+  float pixelsPerUnit = projection[1][1] * 0.5F * static_cast<float>(height);
+  for (const auto& instance : instances)
+  {
+    glm::mat4 modelView = view * instance.transform;
+    float scale = std::max(
+        { glm::length(glm::vec3(instance.transform[0])),
+          glm::length(glm::vec3(instance.transform[1])),
+          glm::length(glm::vec3(instance.transform[2])) });
+
+    for (const auto& mesh : instance.model->getMeshes())
+    {
+      const auto& lods = mesh.getLods();
+      const BoundingSphere& bounds = mesh.getBounds();
+
+      glm::vec3 center = glm::vec3(modelView * glm::vec4(bounds.center, 1.0F));
+      float distance =
+          std::max(glm::length(center) - bounds.radius * scale, 1e-3F);
+
+      unsigned char level = 0;
+      while (lodSelection && level + 1u < lods.size() &&
+             lods[level + 1].error * scale / distance * pixelsPerUnit <=
+                 LOD_PIXEL_ERROR)
+      {
+        level++;
+      }
+      lodLevels.push_back(level);
+    }
+  }
+}
+
+// Object entries, cull slots and indirect commands are numbered across the
+// whole scene, so the first of each per instance is counted up front. Chunks
+// of instances then record into their own CommandBuffer on the job system
+// and are appended in order. Recording issues no GL calls.
+void Renderer::record(const std::vector<RenderInstance>& instances)
+{
+  PROFILE_FUNCTION();
+
+  const Shader& shader =
+      shadingMode == ShadingMode::DEFERRED ? *gBufferShader : sceneShader;
+
+  std::vector<std::size_t> firstObjects(instances.size());
+  std::vector<std::size_t> firstCandidates(instances.size());
+  std::size_t objectCount = 0, candidateCount = 0;
+  for (std::size_t i = 0; i < instances.size(); i++)
+  {
+    firstObjects[i] = objectCount;
+    firstCandidates[i] = candidateCount;
+    for (const auto& mesh : instances[i].model->getMeshes())
+    {
+      unsigned char level = lodLevels[objectCount++];
+      bool perMeshlet = level == 0 && !mesh.getMeshlets().empty();
+      candidateCount += perMeshlet ? mesh.getMeshlets().size() : 1;
+    }
+  }
+
+  bool multiDraw = gpuCuller == nullptr && meshletCulling;
+  culledDraws.assign(multiDraw ? objectCount : 0, { nullptr, 0, 0 });
+  std::vector<CullCandidate> candidates(
+      gpuCuller != nullptr ? candidateCount : 0);
+
+  std::size_t chunkCount =
+      (instances.size() + RECORD_GRAIN_SIZE - 1) / RECORD_GRAIN_SIZE;
+  recordChunks.resize(chunkCount);
+  std::vector<RenderStats> chunkStats(chunkCount, { 0, 0, 0, 0, 0 });
+
+  auto recordChunk = [&](std::size_t chunk)
+  {
+    CommandBuffer& chunkCommands = recordChunks[chunk];
+    RenderStats& drawStats = chunkStats[chunk];
+    chunkCommands.clear();
+
+    std::size_t begin = chunk * RECORD_GRAIN_SIZE;
+    std::size_t end = std::min(instances.size(), begin + RECORD_GRAIN_SIZE);
+    std::vector<CullCandidate> chunkCandidates;
+    for (std::size_t i = begin; i < end; i++)
+    {
+      std::size_t object = firstObjects[i];
+      for (const auto& mesh : instances[i].model->getMeshes())
+      {
+        unsigned char level = lodLevels[object];
+
+        chunkCommands.bindUniformRange(
+            OBJECT_BINDING,
+            dynamicUniforms.getId(),
+            object * objectStride,
+            sizeof(ObjectUniforms));
+
+        if (gpuCuller != nullptr)
+        {
+          std::size_t firstCommand =
+              firstCandidates[begin] + chunkCandidates.size();
+          std::size_t chunkFirst = chunkCandidates.size();
+          recordCandidates(mesh, object, level, chunkCandidates);
+          mesh.recordIndirect(
+              shader,
+              chunkCommands,
+              firstCommand,
+              static_cast<unsigned int>(chunkCandidates.size() - chunkFirst));
+
+          drawStats.drawCalls++;
+          drawStats.triangles += mesh.getIndexCount(level) / 3;
+        }
+        else if (meshletCulling)
+        {
+          mesh.recordMultiDraw(shader, chunkCommands, object);
+          culledDraws[object] = { &mesh, i, level };
+        }
+        else
+        {
+          mesh.record(shader, chunkCommands, level);
+
+          drawStats.drawCalls++;
+          drawStats.triangles += mesh.getIndexCount(level) / 3;
+        }
+        object++;
+      }
+    }
+
+    if (begin < end)
+    {
+      std::copy(
+          chunkCandidates.begin(),
+          chunkCandidates.end(),
+          candidates.begin() +
+              static_cast<std::ptrdiff_t>(firstCandidates[begin]));
+    }
+  };
+
+  auto recordRange = [&](std::size_t begin, std::size_t end)
+  {
+    for (std::size_t chunk = begin; chunk < end; chunk++)
+      recordChunk(chunk);
+  };
+  if (jobs == nullptr)
+    recordRange(0, chunkCount);
+  else
+    jobs->parallelFor(chunkCount, 1, recordRange);
+
+  commands.clear();
+  recordedStats = { 0, 0, 0, 0, 0 };
+  for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+  {
+    commands.append(recordChunks[chunk]);
+    recordedStats.drawCalls += chunkStats[chunk].drawCalls;
+    recordedStats.triangles += chunkStats[chunk].triangles;
+  }
+
+  if (gpuCuller != nullptr)
+    gpuCuller->setCandidates(candidates);
+
+  recordedInstances = instances;
+  recordedLodLevels = lodLevels;
+  commandsValid = true;
+}
+
+// Full-detail meshes contribute one candidate per meshlet; coarser LODs are
+// a single candidate that the normal cone never rejects.
+void Renderer::recordCandidates(
+    const Mesh& mesh,
+    std::size_t object,
+    unsigned char level,
+    std::vector<CullCandidate>& candidates) const
+{
+  auto index = static_cast<unsigned int>(object);
+  if (level == 0 && !mesh.getMeshlets().empty())
+  {
+    for (const auto& meshlet : mesh.getMeshlets())
+    {
+      candidates.push_back(
+          { glm::vec4(meshlet.bounds.center, meshlet.bounds.radius),
+            glm::vec4(meshlet.coneAxis, meshlet.coneCutoff),
+            meshlet.indexCount,
+            meshlet.firstIndex,
+            index });
+    }
+    return;
+  }
+
+  const MeshLod& lod = mesh.getLods()[level];
+  const BoundingSphere& bounds = mesh.getBounds();
+  candidates.push_back({ glm::vec4(bounds.center, bounds.radius),
+                         glm::vec4(0.0F, 0.0F, 0.0F, 1.0F),
+                         lod.indexCount,
+                         lod.firstIndex,
+                         index });
+}
+
+// Occluders are drawn at full detail; simplified LODs may bulge past the
+// surface they replace and hide geometry that is actually visible.
+void Renderer::renderOccluders(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const std::vector<RenderInstance>& instances)
+{
+  PROFILE_FUNCTION();
+  occludersRendered = false;
+  if (!occlusionCulling || !meshletCulling)
+    return;
+
+  occlusionBuffer.clear();
+  for (const auto& instance : instances)
+  {
+    if (!instance.occluder)
+      continue;
+
+    glm::mat4 modelViewProjection = projection * view * instance.transform;
+    for (const auto& mesh : instance.model->getMeshes())
+    {
+      if (mesh.hasPositionStream())
+      {
+        occlusionBuffer.addOccluder(
+            mesh.getPositions(),
+            mesh.getIndices(),
+            mesh.getIndexCount(0),
+            modelViewProjection);
+        continue;
+      }
+      occlusionBuffer.addOccluder(
+          mesh.getVertices(),
+          mesh.getIndices(),
+          mesh.getIndexCount(0),
+          modelViewProjection);
+    }
+    occludersRendered = true;
+  }
+
+  if (occludersRendered)
+    occlusionBuffer.finish();
+}
+
+// Tests each recorded mesh against the frustum and the occlusion buffer, then
+// its meshlets against the frustum, their normal cones when back faces are
+// culled, and the occlusion buffer, in model space. Survivors are merged into
+// contiguous index ranges for glMultiDrawElements. Meshes drawn at a coarser
+// LOD are kept or dropped whole. Draws are spread over the job system.
+void Renderer::cull(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const std::vector<RenderInstance>& instances)
+{
+  PROFILE_FUNCTION();
+  culledRanges.resize(culledDraws.size());
+  culledStats.assign(culledDraws.size(), { 0, 0, 0, 0, 0 });
+
+  auto cullDraws = [&](std::size_t begin, std::size_t end)
+  {
+    for (std::size_t slot = begin; slot < end; slot++)
+    {
+      const CulledDraw& draw = culledDraws[slot];
+      const RenderInstance& instance = instances[draw.instance];
+      const auto& meshlets = draw.mesh->getMeshlets();
+
+      IndexRanges& ranges = culledRanges[slot];
+      RenderStats& drawStats = culledStats[slot];
+      ranges.counts.clear();
+      ranges.offsets.clear();
+      drawStats.totalMeshlets = static_cast<unsigned int>(meshlets.size());
+
+      glm::mat4 modelViewProjection = projection * view * instance.transform;
+      bool testOcclusion = occludersRendered && !instance.occluder;
+
+      Frustum frustum(modelViewProjection);
+      if (!frustum.intersects(draw.mesh->getBounds()))
+        continue;
+      if (testOcclusion && !occlusionBuffer.isVisible(
+                               draw.mesh->getBounds(), modelViewProjection))
+      {
+        drawStats.occludedMeshlets = drawStats.totalMeshlets;
+        continue;
+      }
+
+      unsigned int rangeEnd = 0;
+      auto addRange = [&](unsigned int firstIndex, unsigned int indexCount)
+      {
+        drawStats.triangles += indexCount / 3;
+        if (!ranges.counts.empty() && rangeEnd == firstIndex)
+        {
+          ranges.counts.back() += static_cast<int>(indexCount);
+        }
+        else
+        {
+          ranges.counts.push_back(static_cast<int>(indexCount));
+          ranges.offsets.push_back(reinterpret_cast<const void*>(
+              firstIndex * sizeof(unsigned int)));
+        }
+        rangeEnd = firstIndex + indexCount;
+      };
+
+      if (draw.level != 0 || meshlets.empty())
+      {
+        const MeshLod& lod = draw.mesh->getLods()[draw.level];
+        addRange(lod.firstIndex, lod.indexCount);
+      }
+      else
+      {
+        glm::vec3 eye = glm::vec3(
+            glm::inverse(view * instance.transform) * glm::vec4(0, 0, 0, 1));
+
+        for (const auto& meshlet : meshlets)
+        {
+          if (!frustum.intersects(meshlet.bounds))
+            continue;
+
+          glm::vec3 toCenter = meshlet.bounds.center - eye;
+          if (backFaceCulling &&
+              glm::dot(toCenter, meshlet.coneAxis) >=
+                  meshlet.coneCutoff * glm::length(toCenter) +
+                      meshlet.bounds.radius)
+          {
+            continue;
+          }
+
+          if (testOcclusion &&
+              !occlusionBuffer.isVisible(meshlet.bounds, modelViewProjection))
+          {
+            drawStats.occludedMeshlets++;
+            continue;
+          }
+
+          drawStats.visibleMeshlets++;
+          addRange(meshlet.firstIndex, meshlet.indexCount);
+        }
+      }
+
+      if (!ranges.counts.empty())
+        drawStats.drawCalls++;
+    }
+  };
+
+  if (jobs == nullptr)
+    cullDraws(0, culledDraws.size());
+  else
+    jobs->parallelFor(culledDraws.size(), CULL_GRAIN_SIZE, cullDraws);
+}
+
+// Casters are culled per cascade against the cascade's light frustum and
+// recorded for a depth-only pass into its tile of the atlas. The cascade
+// matrix goes in the Frame block's projection slot so the depth shader is
+// reused as is. Runs before the ring buffer is flushed.
+void Renderer::updateShadows(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const std::vector<RenderInstance>& instances)
+{
+  PROFILE_FUNCTION();
+  shadowMap->update(view, projection, light.direction);
+
+  for (std::size_t c = 0; c < CascadedShadowMap::CASCADE_COUNT; c++)
+  {
+    const ShadowCascade& cascade = shadowMap->getCascade(c);
+    FrameUniforms frameUniforms = { cascade.viewProjection, glm::mat4(1.0F) };
+    RingAllocation frameData =
+        dynamicUniforms.allocate(sizeof(FrameUniforms));
+    std::memcpy(frameData.data, &frameUniforms, sizeof(FrameUniforms));
+    cascadeFrameOffsets[c] = frameData.offset;
+
+    CommandBuffer& casters = shadowCommands[c];
+    casters.clear();
+
+    // Every Object entry of an instance holds its transform, which is all
+    // the depth shader reads, so one binding serves all of its meshes.
+    std::size_t meshIndex = 0;
+    for (std::size_t i = 0; i < instances.size(); i++)
+    {
+      Frustum frustum(cascade.viewProjection * instances[i].transform);
+      std::size_t firstObject = meshIndex;
+      bool bound = false;
+      for (const auto& mesh : instances[i].model->getMeshes())
+      {
+        unsigned char level = lodLevels[meshIndex++];
+        if (!frustum.intersects(mesh.getBounds()))
+          continue;
+
+        if (!bound)
+        {
+          casters.bindUniformRange(
+              OBJECT_BINDING,
+              dynamicUniforms.getId(),
+              firstObject * objectStride,
+              sizeof(glm::mat4));
+          bound = true;
+        }
+        mesh.record(depthShader, casters, level);
+      }
+    }
+  }
+}
+
+void Renderer::drawShadows(std::size_t objectBase)
+{
+  GLint framebuffer = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+
+  // Casters draw both faces so open geometry still casts from behind.
+  if (reverseZ)
+    setDepthConvention(false);
+  glDisable(GL_CULL_FACE);
+  shadowMap->begin();
+  depthShader.bind();
+  for (std::size_t c = 0; c < CascadedShadowMap::CASCADE_COUNT; c++)
+  {
+    GpuProfileScope cascadeScope(gpuProfiler, CASCADE_SCOPES[c]);
+    shadowMap->beginCascade(c);
+    glBindBufferRange(
+        GL_UNIFORM_BUFFER,
+        FRAME_BINDING,
+        dynamicUniforms.getId(),
+        cascadeFrameOffsets[c],
+        sizeof(FrameUniforms));
+    shadowCommands[c].executeGeometry(objectBase);
+  }
+  shadowMap->end();
+  if (backFaceCulling)
+    glEnable(GL_CULL_FACE);
+  if (reverseZ)
+    setDepthConvention(true);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, static_cast<unsigned int>(framebuffer));
+  glViewport(0, 0, width, height);
+}
+
+// Reverse-Z clips depth to [0, 1], clears to 0 and keeps the greater depth.
+// Cascades use glm::ortho matrices and stay forward.
+void Renderer::setDepthConvention(bool reversed) const noexcept
+{
+  GLExtensions::glClipControl(
+      GL_LOWER_LEFT, reversed ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE);
+  glClearDepth(reversed ? 0.0 : 1.0);
+  glDepthFunc(reversed ? GL_GREATER : GL_LESS);
+}
+
+// The forward and deferred lighting shaders share these uniforms. Point
+// lights are looked up through the light grid's tiles in both.
+void Renderer::setLightUniforms(const Shader& shader, const glm::mat4& view)
+    const
+{
+  shader.bind();
+  shader.setVec3("viewPosition", glm::vec3(glm::inverse(view)[3]));
+  shader.setVec3("dirLight.direction", light.direction);
+  shader.setVec3("dirLight.ambient", light.ambient);
+  shader.setVec3("dirLight.diffuse", light.diffuse);
+  shader.setVec3("dirLight.specular", light.specular);
+  shader.setInt("tilesX", lightGrid->getTilesX());
+  shader.setBool("shadowsEnabled", shadowMap != nullptr);
+
+  glActiveTexture(GL_TEXTURE0 + LIGHT_UNIT);
+  glBindTexture(GL_TEXTURE_BUFFER, lightGrid->getLightTexture());
+  glActiveTexture(GL_TEXTURE0 + TILE_UNIT);
+  glBindTexture(GL_TEXTURE_BUFFER, lightGrid->getTileTexture());
+
+  if (shadowMap != nullptr)
+  {
+    std::array<glm::mat4, CascadedShadowMap::CASCADE_COUNT> matrices;
+    std::array<float, CascadedShadowMap::CASCADE_COUNT> splits;
+    for (std::size_t c = 0; c < CascadedShadowMap::CASCADE_COUNT; c++)
+    {
+      matrices[c] = shadowMap->getCascade(c).shadowMatrix;
+      splits[c] = shadowMap->getCascade(c).splitFar;
+    }
+
+    glUniformMatrix4fv(
+        shader.getUniformLocation("cascadeMatrices"),
+        static_cast<GLsizei>(matrices.size()),
+        GL_FALSE,
+        glm::value_ptr(matrices.front()));
+    glUniform1fv(
+        shader.getUniformLocation("cascadeSplits"),
+        static_cast<GLsizei>(splits.size()),
+        splits.data());
+
+    glActiveTexture(GL_TEXTURE0 + SHADOW_UNIT);
+    glBindTexture(GL_TEXTURE_2D, shadowMap->getTexture());
+  }
+  glActiveTexture(GL_TEXTURE0);
+}
+
+// Resolves the G-buffer into the target framebuffer; expects the Frame block
+// to still hold the camera matrices.
+void Renderer::drawLighting(
+    const glm::mat4& view,
+    const glm::mat4& projection) const
+{
+  lightingShader->bind();
+  lightingShader->setMat4(
+      "inverseViewProjection", glm::inverse(projection * view));
+  gBuffer->drawLighting(GBUFFER_UNIT);
+}
+
+// Depth-only execution swaps in the position-only shader, which computes
+// gl_Position exactly like the scene shader.
+void Renderer::executeCommands(
+    std::size_t objectBase,
+    const std::vector<IndexRanges>* ranges,
+    bool depthOnly) const
+{
+  if (!depthOnly)
+  {
+    commands.execute(objectBase, ranges);
+    return;
+  }
+
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  depthShader.bind();
+  commands.executeGeometry(objectBase, ranges);
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+// Two-phase occlusion culling: draw what was visible last frame, build the
+// depth pyramid from that, then draw whatever the pyramid does not hide.
+// Everything stays on the GPU, so stats only count submitted geometry.
+void Renderer::drawGpuCulled(
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    std::size_t objectBase,
+    bool depthOnly)
+{
+  GLint framebuffer = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+
+  gpuCuller->cull(
+      CullPhase::PREVIOUSLY_VISIBLE,
+      view,
+      projection,
+      objectBase,
+      objectStride,
+      backFaceCulling);
+  executeCommands(objectBase, nullptr, depthOnly);
+
+  {
+    GpuProfileScope pyramidScope(gpuProfiler, "DepthPyramid");
+    gpuCuller->buildPyramid(static_cast<unsigned int>(framebuffer));
+  }
+
+  gpuCuller->cull(
+      CullPhase::OCCLUSION_TESTED,
+      view,
+      projection,
+      objectBase,
+      objectStride,
+      backFaceCulling);
+  executeCommands(objectBase, nullptr, depthOnly);
+
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+// Shades against the pre-pass depth. GPU culling replays both phases'
+// commands rather than culling again, which would overwrite the visibility
+// recorded for the next frame.
+void Renderer::drawShading(std::size_t objectBase) const
+{
+  if (gpuCuller == nullptr)
+  {
+    commands.execute(objectBase, &culledRanges);
+    return;
+  }
+
+  gpuCuller->bindCommands(CullPhase::PREVIOUSLY_VISIBLE);
+  commands.execute(objectBase);
+  gpuCuller->bindCommands(CullPhase::OCCLUSION_TESTED);
+  commands.execute(objectBase);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+RendererBuilder& RendererBuilder::withShaderDirectory(
+    const std::string& directory)
+{
+  shaderDirectory = directory;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withPackedTextures(
+    bool packedTextures) noexcept
+{
+  this->packedTextures = packedTextures;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withClearColor(glm::vec4 clearColor) noexcept
+{
+  this->clearColor = clearColor;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withViewport(int width, int height) noexcept
+{
+  this->width = width;
+  this->height = height;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withJobSystem(JobSystem& jobs) noexcept
+{
+  this->jobs = &jobs;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withGpuCulling(bool gpuCulling) noexcept
+{
+  this->gpuCulling = gpuCulling;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withShadows(bool shadows) noexcept
+{
+  this->shadows = shadows;
+  return *this;
+}
+
+RendererBuilder& RendererBuilder::withDeferredShading(
+    bool deferredShading) noexcept
+{
+  this->deferredShading = deferredShading;
+  return *this;
+}
+
+// Expects reverse-Z infinite projections (ProjectionBuilder::withReverseZ)
+// and a DEPTH32F_STENCIL8 target. Falls back to forward depth without
+// glClipControl; check Renderer::hasReverseZ.
+RendererBuilder& RendererBuilder::withReverseZ(bool reverseZ) noexcept
+{
+  this->reverseZ = reverseZ;
+  return *this;
+}
+
+Renderer RendererBuilder::build() const
+{
+  if (width <= 0 || height <= 0)
+  {
+    throw std::runtime_error("Invalid Argument: Viewport");
+  }
+  if (shadows && packedTextures)
+  {
+    throw std::runtime_error("Invalid Argument: Shadows with packed textures");
+  }
+  if (deferredShading && packedTextures)
+  {
+    throw std::runtime_error(
+        "Invalid Argument: Deferred shading with packed textures");
+  }
+
+  return Renderer(
+      shaderDirectory,
+      packedTextures,
+      clearColor,
+      width,
+      height,
+      jobs,
+      gpuCulling,
+      shadows,
+      deferredShading,
+      reverseZ);
+}
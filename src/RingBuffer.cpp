@@ -0,0 +1,153 @@
+#include "RingBuffer.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "GLExtensions.hpp"
+#include "Profiler.hpp"
+#include "glad/glad.h"
+
+RingBuffer::RingBuffer(unsigned int target, std::size_t frameCapacity)
+    : target(target),
+      persistent(GLExtensions::hasBufferStorage())
+{
+  GLint offsetAlignment = 1;
+  if (target == GL_UNIFORM_BUFFER)
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+  alignment = static_cast<std::size_t>(offsetAlignment);
+
+  this->frameCapacity =
+      (frameCapacity + alignment - 1) / alignment * alignment;
+
+  glGenBuffers(1, &buffer);
+  glBindBuffer(target, buffer);
+
+  if (persistent)
+  {
+    constexpr GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    std::size_t size = this->frameCapacity * FRAME_COUNT;
+
+    GLExtensions::glBufferStorage(target, size, nullptr, flags);
+    mapped =
+        static_cast<unsigned char*>(glMapBufferRange(target, 0, size, flags));
+  }
+  else
+  {
+    glBufferData(target, this->frameCapacity, nullptr, GL_STREAM_DRAW);
+  }
+  glBindBuffer(target, 0);
+
+  if (persistent && mapped == nullptr)
+  {
+    glDeleteBuffers(1, &buffer);
+    throw std::runtime_error("ERROR::RING_BUFFER::MAPPING_FAILED");
+  }
+}
+
+RingBuffer::~RingBuffer() noexcept
+{
+  for (void* fence : fences)
+  {
+    if (fence != nullptr)
+      glDeleteSync(static_cast<GLsync>(fence));
+  }
+
+  if (mapped != nullptr)
+  {
+    glBindBuffer(target, buffer);
+    glUnmapBuffer(target);
+    glBindBuffer(target, 0);
+  }
+  glDeleteBuffers(1, &buffer);
+}
+
+void RingBuffer::beginFrame()
+{
+  PROFILE_SCOPE("RingBuffer::beginFrame");
+  head = 0;
+
+  if (!persistent)
+  {
+    // Orphan the store so the driver hands back fresh memory while the
+    // previous frame's draws still read the old one.
+    glBindBuffer(target, buffer);
+    glBufferData(target, frameCapacity, nullptr, GL_STREAM_DRAW);
+    mapped = static_cast<unsigned char*>(glMapBufferRange(
+        target,
+        0,
+        frameCapacity,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    glBindBuffer(target, 0);
+
+    if (mapped == nullptr)
+      throw std::runtime_error("ERROR::RING_BUFFER::MAPPING_FAILED");
+    return;
+  }
+
+  frameIndex = (frameIndex + 1) % FRAME_COUNT;
+  frameBase = frameIndex * frameCapacity;
+
+  if (fences[frameIndex] != nullptr)
+  {
+    constexpr GLuint64 WAIT_TIMEOUT_NS = 1'000'000'000;
+    auto fence = static_cast<GLsync>(fences[frameIndex]);
+
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT_NS);
+    glDeleteSync(fence);
+    fences[frameIndex] = nullptr;
+  }
+}
+
+RingAllocation RingBuffer::allocate(std::size_t size)
+{
+  std::size_t offset = head;
+  std::size_t end = offset + (size + alignment - 1) / alignment * alignment;
+
+  if (end > frameCapacity || mapped == nullptr)
+    throw std::runtime_error("ERROR::RING_BUFFER::OUT_OF_MEMORY");
+
+  head = end;
+
+  std::size_t absolute = frameBase + offset;
+  return { mapped + absolute, absolute, size };
+}
+
+void RingBuffer::flush()
+{
+  if (persistent || mapped == nullptr)
+    return;
+
+  glBindBuffer(target, buffer);
+  glUnmapBuffer(target);
+  glBindBuffer(target, 0);
+  mapped = nullptr;
+}
+
+void RingBuffer::endFrame()
+{
+  if (!persistent)
+    return;
+
+  fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+unsigned int RingBuffer::getId() const noexcept
+{
+  return buffer;
+}
+
+std::size_t RingBuffer::getSize() const noexcept
+{
+  return persistent ? frameCapacity * FRAME_COUNT : frameCapacity;
+}
+
+std::size_t RingBuffer::getAlignment() const noexcept
+{
+  return alignment;
+}
+
+bool RingBuffer::isPersistent() const noexcept
+{
+  return persistent;
+}
@@ -1,6 +1,7 @@
 #include "Shader.hpp"
 
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -8,48 +9,51 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "glad/glad.h"
 
 Shader::Shader(const std::string& vPath, const std::string& fPath)
 {
-  std::string vSource, fSource;
-  std::stringstream vSourceSS, fSourceSS;
-  std::ifstream vShaderFile, fShaderFile;
+  GLuint vertexId = compile(GL_VERTEX_SHADER, vPath);
+  GLuint fragmentId = compile(GL_FRAGMENT_SHADER, fPath);
 
-  vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-  fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-  vShaderFile.open(vPath);
-  fShaderFile.open(fPath);
-
-  vSourceSS << vShaderFile.rdbuf();
-  fSourceSS << fShaderFile.rdbuf();
-
-  vSource = vSourceSS.str();
-  fSource = fSourceSS.str();
+  programId = glCreateProgram();
+  glAttachShader(programId, vertexId);
+  glAttachShader(programId, fragmentId);
 
-  const char *vSourcePtr = vSource.c_str(), *fSourcePtr = fSource.c_str();
+  glLinkProgram(programId);
+  checkStatus(programId, "PROGRAM");
 
-  GLuint vertexId = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexId, 1, &vSourcePtr, nullptr);
-  glCompileShader(vertexId);
-  checkStatus(vertexId, "VERTEX");
+  glDeleteShader(vertexId);
+  glDeleteShader(fragmentId);
+}
 
-  GLuint fragmentId = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentId, 1, &fSourcePtr, nullptr);
-  glCompileShader(fragmentId);
-  checkStatus(fragmentId, "FRAGMENT");
+// Vertex-only program whose outputs are captured with transform feedback,
+// interleaved in the order given.
+Shader::Shader(
+    const std::string& vPath,
+    const std::vector<std::string>& feedbackVaryings)
+{
+  GLuint vertexId = compile(GL_VERTEX_SHADER, vPath);
 
   programId = glCreateProgram();
   glAttachShader(programId, vertexId);
-  glAttachShader(programId, fragmentId);
+
+  std::vector<const char*> varyings;
+  for (const auto& varying : feedbackVaryings)
+    varyings.push_back(varying.c_str());
+  glTransformFeedbackVaryings(
+      programId,
+      static_cast<GLsizei>(varyings.size()),
+      varyings.data(),
+      GL_INTERLEAVED_ATTRIBS);
 
   glLinkProgram(programId);
   checkStatus(programId, "PROGRAM");
 
   glDeleteShader(vertexId);
-  glDeleteShader(fragmentId);
 }
 
 Shader::~Shader() noexcept
@@ -80,6 +84,20 @@ GLuint Shader::getProgramId() const noexcept
   return programId;
 }
 
+int Shader::getUniformLocation(const std::string& name) const noexcept
+{
+  return glGetUniformLocation(programId, name.c_str());
+}
+
+void Shader::setUniformBlockBinding(
+    const std::string& name,
+    unsigned int binding) const noexcept
+{
+  GLuint index = glGetUniformBlockIndex(programId, name.c_str());
+  if (index != GL_INVALID_INDEX)
+    glUniformBlockBinding(programId, index, binding);
+}
+
 void Shader::bind() const noexcept
 {
   glUseProgram(programId);
@@ -171,6 +189,53 @@ void Shader::setMat4(const std::string& name, glm::mat4 mat) const noexcept
       glm::value_ptr(mat));
 }
 
+// Lines of the form #include "file" are replaced by that file's source,
+// resolved relative to the including file, so passes can share functions.
+std::string Shader::readFile(const std::string& path)
+{
+  std::stringstream sourceSS;
+  std::ifstream shaderFile;
+
+  shaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  shaderFile.open(path);
+  sourceSS << shaderFile.rdbuf();
+
+  constexpr std::string_view INCLUDE = "#include \"";
+
+  std::string source;
+  std::string line;
+  while (std::getline(sourceSS, line))
+  {
+    if (line.starts_with(INCLUDE) && line.back() == '"')
+    {
+      std::string name =
+          line.substr(INCLUDE.size(), line.size() - INCLUDE.size() - 1);
+      source += readFile(
+          (std::filesystem::path(path).parent_path() / name).string());
+    }
+    else
+    {
+      source += line;
+      source += '\n';
+    }
+  }
+
+  return source;
+}
+
+GLuint Shader::compile(GLenum type, const std::string& path) const
+{
+  std::string source = readFile(path);
+  const char* sourcePtr = source.c_str();
+
+  GLuint id = glCreateShader(type);
+  glShaderSource(id, 1, &sourcePtr, nullptr);
+  glCompileShader(id);
+  checkStatus(id, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
+
+  return id;
+}
+
 void Shader::checkStatus(GLuint id, const std::string& type) const
 {
   using namespace std::string_literals;
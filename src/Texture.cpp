@@ -1,35 +1,46 @@
 #include "Texture.hpp"
 
-#include <stdexcept>
 #include <string>
 
+#include "Image.hpp"
+#include "Profiler.hpp"
 #include "glad/glad.h"
-#include "stb/image.h"
 
-Texture::Texture(const std::string& path, Type type) : textureType(type)
+Texture::Texture(const std::string& path, Type type)
+    : Texture(Image(path), type)
+{ }
+
+Texture::Texture(const Image& image, Type type)
+    : Texture(image.getWidth(), image.getHeight(), image.getChannels(), type)
 {
-  int width, height, nrChannels;
-  std::unique_ptr<unsigned char, decltype(&stbi_image_free)> image(
-      stbi_load(path.c_str(), &width, &height, &nrChannels, 0),
-      stbi_image_free);
+  PROFILE_SCOPE("Texture::upload");
+  glBindTexture(GL_TEXTURE_2D, textureId);
 
-  if (image.get() == nullptr)
-  {
-    throw std::runtime_error("ERROR::STB_IMAGE::LOADING_FAILED: " + path);
-  }
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(
+      GL_TEXTURE_2D,
+      0,
+      0,
+      0,
+      image.getWidth(),
+      image.getHeight(),
+      formatFromChannels(image.getChannels()),
+      GL_UNSIGNED_BYTE,
+      image.data());
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  glGenerateMipmap(GL_TEXTURE_2D);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
 
+Texture::Texture(int width, int height, int channels, Type type)
+    : textureType(type)
+{
   glGenTextures(1, &textureId);
   glBindTexture(GL_TEXTURE_2D, textureId);
 
-  GLenum format = GL_RGB;
-  switch (nrChannels)
-  {
-    case 1: format = GL_RED; break;
-    case 2: format = GL_RG; break;
-    case 3: format = GL_RGB; break;
-    case 4: format = GL_RGBA; break;
-    default: break;
-  }
+  GLenum format = formatFromChannels(channels);
 
   glTexImage2D(
       GL_TEXTURE_2D,
@@ -40,9 +51,7 @@ Texture::Texture(const std::string& path, Type type) : textureType(type)
       0,
       format,
       GL_UNSIGNED_BYTE,
-      image.get());
-
-  glGenerateMipmap(GL_TEXTURE_2D);
+      nullptr);
 
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -90,9 +99,27 @@ Texture::Type Texture::getType() const noexcept
 
 std::string Texture::typeStr() const noexcept
 {
-  switch (textureType)
+  return typeStr(textureType);
+}
+
+std::string Texture::typeStr(Type type) noexcept
+{
+  switch (type)
   {
     case Type::DIFFUSE: return "texture_diffuse";
     case Type::SPECULAR: return "texture_specular";
   }
+  return "";
+}
+
+GLenum Texture::formatFromChannels(int channels) noexcept
+{
+  switch (channels)
+  {
+    case 1: return GL_RED;
+    case 2: return GL_RG;
+    case 3: return GL_RGB;
+    case 4: return GL_RGBA;
+    default: return GL_RGB;
+  }
 }
@@ -0,0 +1,126 @@
+#include "TextureArray.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "Image.hpp"
+#include "Profiler.hpp"
+#include "Texture.hpp"
+#include "glad/glad.h"
+
+TextureArray::TextureArray(const std::vector<const Image*>& images)
+    : layers(static_cast<int>(images.size()))
+{
+  PROFILE_SCOPE("TextureArray::upload");
+  if (images.empty() || layers > maxLayers())
+  {
+    throw std::runtime_error("ERROR::TEXTURE_ARRAY::INVALID_LAYER_COUNT");
+  }
+
+  width = images.front()->getWidth();
+  height = images.front()->getHeight();
+  channels = images.front()->getChannels();
+
+  for (const Image* image : images)
+  {
+    if (image->getWidth() != width || image->getHeight() != height ||
+        image->getChannels() != channels)
+    {
+      throw std::runtime_error("ERROR::TEXTURE_ARRAY::INCOMPATIBLE_LAYER");
+    }
+  }
+
+  GLenum format = Texture::formatFromChannels(channels);
+
+  glGenTextures(1, &textureId);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, textureId);
+
+  glTexImage3D(
+      GL_TEXTURE_2D_ARRAY,
+      0,
+      format,
+      width,
+      height,
+      layers,
+      0,
+      format,
+      GL_UNSIGNED_BYTE,
+      nullptr);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  for (int i = 0; i < layers; i++)
+  {
+    glTexSubImage3D(
+        GL_TEXTURE_2D_ARRAY,
+        0,
+        0,
+        0,
+        i,
+        width,
+        height,
+        1,
+        format,
+        GL_UNSIGNED_BYTE,
+        images[i]->data());
+  }
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(
+      GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureArray::~TextureArray() noexcept
+{
+  glDeleteTextures(1, &textureId);
+}
+
+TextureArray::TextureArray(TextureArray&& other)
+    : textureId(other.textureId),
+      width(other.width),
+      height(other.height),
+      channels(other.channels),
+      layers(other.layers)
+{
+  other.textureId = 0;
+}
+
+TextureArray& TextureArray::operator=(TextureArray&& other)
+{
+  if (this != &other)
+  {
+    glDeleteTextures(1, &textureId);
+
+    textureId = other.textureId;
+    width = other.width;
+    height = other.height;
+    channels = other.channels;
+    layers = other.layers;
+
+    other.textureId = 0;
+  }
+  return *this;
+}
+
+GLuint TextureArray::getId() const noexcept
+{
+  return textureId;
+}
+
+int TextureArray::getLayerCount() const noexcept
+{
+  return layers;
+}
+
+int TextureArray::maxLayers() noexcept
+{
+  GLint maxLayers = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+  return maxLayers;
+}
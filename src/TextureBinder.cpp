@@ -0,0 +1,32 @@
+#include "TextureBinder.hpp"
+
+#include "glad/glad.h"
+
+void TextureBinder::bind(
+    unsigned int unit,
+    unsigned int target,
+    unsigned int id) noexcept
+{
+  if (unit < MAX_UNITS && boundIds[unit] == id)
+  {
+    skipCount++;
+    return;
+  }
+
+  glActiveTexture(GL_TEXTURE0 + unit);
+  glBindTexture(target, id);
+  bindCount++;
+
+  if (unit < MAX_UNITS)
+    boundIds[unit] = id;
+}
+
+unsigned int TextureBinder::getBindCount() const noexcept
+{
+  return bindCount;
+}
+
+unsigned int TextureBinder::getSkipCount() const noexcept
+{
+  return skipCount;
+}
@@ -0,0 +1,264 @@
+#include "TextureStreamer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "GLExtensions.hpp"
+#include "Profiler.hpp"
+#include "Texture.hpp"
+#include "glad/glad.h"
+#include "stb/image.h"
+
+TextureStreamer::TextureStreamer()
+    : persistent(GLExtensions::hasBufferStorage())
+{ }
+
+TextureStreamer::~TextureStreamer() noexcept
+{
+  for (auto& slot : slots)
+  {
+    if (slot.decoded.valid())
+      slot.decoded.wait();
+
+    if (slot.fence != nullptr)
+      glDeleteSync(static_cast<GLsync>(slot.fence));
+
+    if (slot.pbo != 0)
+    {
+      if (slot.mapped != nullptr)
+      {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+      }
+      glDeleteBuffers(1, &slot.pbo);
+    }
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+std::shared_ptr<Texture> TextureStreamer::load(
+    const std::string& path,
+    Texture::Type type)
+{
+  int width, height, channels;
+  if (!stbi_info(path.c_str(), &width, &height, &channels))
+  {
+    throw std::runtime_error("ERROR::STB_IMAGE::LOADING_FAILED: " + path);
+  }
+
+  auto texture = std::make_shared<Texture>(width, height, channels, type);
+  queue.push_back({ texture, path, width, height, channels });
+
+  return texture;
+}
+
+void TextureStreamer::update()
+{
+  PROFILE_SCOPE("TextureStreamer::update");
+  using namespace std::chrono_literals;
+
+  for (auto& slot : slots)
+  {
+    if (slot.decoded.valid() &&
+        slot.decoded.wait_for(0s) == std::future_status::ready)
+    {
+      endUpload(slot);
+    }
+  }
+
+  for (auto& slot : slots)
+  {
+    if (slot.fence != nullptr)
+      retire(slot, false);
+  }
+
+  for (auto& slot : slots)
+  {
+    if (queue.empty())
+      break;
+    if (slot.busy)
+      continue;
+
+    beginUpload(slot, std::move(queue.front()));
+    queue.pop_front();
+  }
+}
+
+void TextureStreamer::finish()
+{
+  while (!isIdle())
+  {
+    for (auto& slot : slots)
+    {
+      if (slot.decoded.valid())
+        endUpload(slot);
+      if (slot.fence != nullptr)
+        retire(slot, true);
+    }
+    update();
+  }
+}
+
+bool TextureStreamer::isIdle() const noexcept
+{
+  if (!queue.empty())
+    return false;
+
+  for (const auto& slot : slots)
+  {
+    if (slot.busy)
+      return false;
+  }
+  return true;
+}
+
+void TextureStreamer::beginUpload(Slot& slot, Request&& request)
+{
+  std::size_t size = static_cast<std::size_t>(request.width) *
+                     request.height * request.channels;
+  reserve(slot, size);
+
+  if (!persistent)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    glBufferData(
+        GL_PIXEL_UNPACK_BUFFER, slot.capacity, nullptr, GL_STREAM_DRAW);
+    slot.mapped = static_cast<unsigned char*>(glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER,
+        0,
+        size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+
+  if (slot.mapped == nullptr)
+  {
+    throw std::runtime_error("ERROR::TEXTURE_STREAMER::MAPPING_FAILED");
+  }
+
+  slot.busy = true;
+  slot.request = std::move(request);
+  slot.decoded = std::async(
+      std::launch::async,
+      [dst = slot.mapped,
+       path = slot.request.path,
+       width = slot.request.width,
+       height = slot.request.height,
+       channels = slot.request.channels,
+       size]()
+      {
+        PROFILE_THREAD("Texture Decode");
+        PROFILE_SCOPE("TextureStreamer::decode");
+
+        int x, y, n;
+        std::unique_ptr<unsigned char, decltype(&stbi_image_free)> image(
+            stbi_load(path.c_str(), &x, &y, &n, channels), stbi_image_free);
+
+        if (image == nullptr || x != width || y != height)
+          return false;
+
+        std::memcpy(dst, image.get(), size);
+        return true;
+      });
+}
+
+void TextureStreamer::endUpload(Slot& slot)
+{
+  bool decoded = slot.decoded.get();
+  const Request& request = slot.request;
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+  if (!persistent)
+  {
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    slot.mapped = nullptr;
+  }
+
+  if (decoded)
+  {
+    glBindTexture(GL_TEXTURE_2D, request.texture->getId());
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        request.width,
+        request.height,
+        Texture::formatFromChannels(request.channels),
+        GL_UNSIGNED_BYTE,
+        nullptr);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  // A failed decode runs on the render thread mid-frame, so it is reported
+  // and the texture keeps its unfilled placeholder storage.
+  if (!decoded)
+  {
+    std::cerr << "ERROR::STB_IMAGE::LOADING_FAILED: " << request.path << '\n';
+  }
+
+  slot.request = Request();
+}
+
+void TextureStreamer::retire(Slot& slot, bool wait) noexcept
+{
+  constexpr GLuint64 WAIT_TIMEOUT_NS = 1'000'000'000;
+
+  GLenum status = glClientWaitSync(
+      static_cast<GLsync>(slot.fence),
+      wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+      wait ? WAIT_TIMEOUT_NS : 0);
+
+  if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+  {
+    glDeleteSync(static_cast<GLsync>(slot.fence));
+    slot.fence = nullptr;
+    slot.busy = false;
+  }
+}
+
+void TextureStreamer::reserve(Slot& slot, std::size_t size)
+{
+  if (slot.pbo != 0 && slot.capacity >= size)
+    return;
+
+  if (!persistent)
+  {
+    if (slot.pbo == 0)
+      glGenBuffers(1, &slot.pbo);
+    slot.capacity = size;
+    return;
+  }
+
+  if (slot.pbo != 0)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glDeleteBuffers(1, &slot.pbo);
+  }
+
+  constexpr GLbitfield flags =
+      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glGenBuffers(1, &slot.pbo);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+  GLExtensions::glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+  slot.mapped = static_cast<unsigned char*>(
+      glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+  slot.capacity = size;
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
@@ -0,0 +1,335 @@
+#define GLFW_INCLUDE_NONE
+
+#include "ViewerApplication.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <chrono>
+#include <glm/glm.hpp>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "Camera.hpp"
+#include "FramePacer.hpp"
+#include "FrameSnapshotBuffer.hpp"
+#include "FrameStats.hpp"
+#include "Model.hpp"
+#include "Profiler.hpp"
+#include "Projection.hpp"
+#include "Renderer.hpp"
+#include "glad/glad.h"
+
+ViewerApplication::ViewerApplication()
+    : window(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE),
+      camera(CameraBuilder().setPosition(0.0F, 0.0F, 3.0F).build()),
+      previousCameraState(camera.getState()),
+      renderCamera(camera),
+      projection(
+          ProjectionBuilder()
+              .withAspectRatio(
+                  static_cast<float>(WINDOW_WIDTH) / WINDOW_HEIGHT)
+              .build()),
+      model(ModelBuilder()
+                .fromFile("./assets/models/backpack/backpack.obj")
+                .withTexturePacking(PACK_TEXTURES)
+                .withTextureStreamer(textureStreamer)
+                .withJobSystem(jobs)
+                .build()),
+      renderer(
+          RendererBuilder()
+              .withJobSystem(jobs)
+              .withPackedTextures(PACK_TEXTURES)
+              .withViewport(WINDOW_WIDTH, WINDOW_HEIGHT)
+              .build())
+{
+  GLFWwindow* handle = window.get();
+  glfwSetWindowUserPointer(handle, this);
+  glfwSetFramebufferSizeCallback(handle, frameBufferSizeCallback);
+  glfwSetInputMode(handle, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+  glfwSetCursorPosCallback(handle, mouseCallback);
+  glfwSetScrollCallback(handle, scrollCallback);
+
+  scene.push_back({ &model, glm::mat4(1.0F), MODEL_OCCLUDES });
+
+  TextureBindReport bindReport = model.getTextureBindReport();
+  std::cout << "Texture binds per frame: " << bindReport.unpackedBinds
+            << " unpacked, " << bindReport.packedBinds << " packed\n";
+
+  glfwMakeContextCurrent(nullptr);
+  renderThread = std::thread(&ViewerApplication::renderLoop, this);
+}
+
+ViewerApplication::~ViewerApplication()
+{
+  stopRenderThread();
+}
+
+const FrameStats& ViewerApplication::getLatencyStats() const noexcept
+{
+  return latencyStats;
+}
+
+bool ViewerApplication::isRunning()
+{
+  if (!glfwWindowShouldClose(window.get()))
+    return true;
+
+  stopRenderThread();
+  return false;
+}
+
+void ViewerApplication::update(double deltaTime)
+{
+  glfwPollEvents();
+  processInput();
+
+  recentFrames.add(deltaTime * 1000.0);
+  recentFramesElapsed += deltaTime;
+  if (recentFramesElapsed >= STATS_INTERVAL)
+  {
+    updateTitle();
+    recentFrames.clear();
+    recentFramesElapsed = 0.0;
+  }
+}
+
+void ViewerApplication::fixedUpdate(double timestep)
+{
+  previousCameraState = camera.getState();
+  moveCamera(static_cast<float>(timestep));
+}
+
+void ViewerApplication::render(double alpha)
+{
+  FrameSnapshot* snapshot = snapshots.beginWrite();
+  if (snapshot == nullptr)
+    return;
+
+  // Mouse look is applied as events arrive rather than per step, so only
+  // the simulated position is blended between steps.
+  CameraState current = camera.getState();
+  CameraState blended = Camera::interpolate(
+      previousCameraState, current, static_cast<float>(alpha));
+  blended.yaw = current.yaw;
+  blended.pitch = current.pitch;
+
+  // Kept across frames so an idle camera keeps its generation and cached
+  // view matrix.
+  renderCamera.setState(blended);
+
+  snapshot->frame = frame++;
+  snapshot->view = renderCamera.getViewMatrix();
+  snapshot->projection = projection.getProjectionMatrix();
+  snapshot->viewGeneration = renderCamera.getGeneration();
+  snapshot->projectionGeneration = projection.getGeneration();
+  snapshot->instances = scene;
+  snapshot->viewportWidth = viewportWidth;
+  snapshot->viewportHeight = viewportHeight;
+  snapshot->swapInterval = FramePacer::swapInterval(swapMode);
+  snapshot->hasInput = hasPendingInput;
+  snapshot->inputTime = pendingInputTime;
+
+  snapshots.publish();
+  hasPendingInput = false;
+}
+
+void ViewerApplication::present()
+{
+}
+
+void ViewerApplication::renderLoop()
+{
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  PROFILE_THREAD("Render");
+  glfwMakeContextCurrent(window.get());
+
+  bool adaptiveSupported =
+      glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+      glfwExtensionSupported("GLX_EXT_swap_control_tear");
+
+  int currentWidth = WINDOW_WIDTH, currentHeight = WINDOW_HEIGHT;
+  int currentSwapInterval = 0;
+  while (const FrameSnapshot* snapshot = snapshots.acquire())
+  {
+    int swapInterval = snapshot->swapInterval;
+    if (swapInterval < 0 && !adaptiveSupported)
+      swapInterval = -swapInterval;
+    if (swapInterval != currentSwapInterval || snapshot->frame == 0)
+    {
+      currentSwapInterval = swapInterval;
+      glfwSwapInterval(swapInterval);
+    }
+
+    if (snapshot->viewportWidth != currentWidth ||
+        snapshot->viewportHeight != currentHeight)
+    {
+      currentWidth = snapshot->viewportWidth;
+      currentHeight = snapshot->viewportHeight;
+      renderer.resize(currentWidth, currentHeight);
+    }
+
+    textureStreamer.update();
+    renderer.render(
+        snapshot->view,
+        snapshot->projection,
+        snapshot->instances,
+        snapshot->viewGeneration,
+        snapshot->projectionGeneration);
+    renderedTriangles.store(
+        renderer.getStats().triangles, std::memory_order_relaxed);
+
+    {
+      PROFILE_SCOPE("ViewerApplication::swapBuffers");
+      glfwSwapBuffers(window.get());
+    }
+
+    if (snapshot->hasInput)
+    {
+      latencyStats.add(
+          Milliseconds(Clock::now() - snapshot->inputTime).count());
+    }
+  }
+
+  glfwMakeContextCurrent(nullptr);
+}
+
+void ViewerApplication::stopRenderThread()
+{
+  if (!renderThread.joinable())
+    return;
+
+  snapshots.close();
+  renderThread.join();
+  glfwMakeContextCurrent(window.get());
+}
+
+void ViewerApplication::processInput()
+{
+  PROFILE_FUNCTION();
+  GLFWwindow* handle = window.get();
+
+  if (glfwGetKey(handle, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+  {
+    glfwSetWindowShouldClose(handle, true);
+  }
+
+  bool swapKey = glfwGetKey(handle, GLFW_KEY_V) == GLFW_PRESS;
+  if (swapKey && !swapKeyDown)
+  {
+    switch (swapMode)
+    {
+      case SwapMode::IMMEDIATE: swapMode = SwapMode::VSYNC; break;
+      case SwapMode::VSYNC: swapMode = SwapMode::ADAPTIVE; break;
+      case SwapMode::ADAPTIVE: swapMode = SwapMode::IMMEDIATE; break;
+    }
+  }
+  swapKeyDown = swapKey;
+
+  bool limiterKey = glfwGetKey(handle, GLFW_KEY_L) == GLFW_PRESS;
+  if (limiterKey && !limiterKeyDown)
+    framePacer.setTargetFps(framePacer.isEnabled() ? 0.0 : FRAME_LIMIT_FPS);
+  limiterKeyDown = limiterKey;
+}
+
+void ViewerApplication::moveCamera(float timestep)
+{
+  GLFWwindow* handle = window.get();
+
+  bool moved = false;
+  if (glfwGetKey(handle, GLFW_KEY_W) == GLFW_PRESS)
+  {
+    camera.updatePosition(Camera::MoveDir::FORWARD, timestep);
+    moved = true;
+  }
+  if (glfwGetKey(handle, GLFW_KEY_S) == GLFW_PRESS)
+  {
+    camera.updatePosition(Camera::MoveDir::BACKWARD, timestep);
+    moved = true;
+  }
+  if (glfwGetKey(handle, GLFW_KEY_A) == GLFW_PRESS)
+  {
+    camera.updatePosition(Camera::MoveDir::LEFT, timestep);
+    moved = true;
+  }
+  if (glfwGetKey(handle, GLFW_KEY_D) == GLFW_PRESS)
+  {
+    camera.updatePosition(Camera::MoveDir::RIGHT, timestep);
+    moved = true;
+  }
+
+  if (moved)
+    markInput();
+}
+
+void ViewerApplication::updateTitle()
+{
+  std::ostringstream title;
+  title << std::fixed << std::setprecision(2) << WINDOW_TITLE << " | "
+        << FramePacer::swapModeStr(swapMode) << " | limit ";
+  if (framePacer.isEnabled())
+    title << framePacer.getTargetFps() << " fps";
+  else
+    title << "off";
+  title << " | p50 " << recentFrames.percentile(0.50) << " ms, p99 "
+        << recentFrames.percentile(0.99) << " ms, max " << recentFrames.max()
+        << " ms | " << renderedTriangles.load(std::memory_order_relaxed)
+        << " tris";
+
+  glfwSetWindowTitle(window.get(), title.str().c_str());
+}
+
+void ViewerApplication::markInput() noexcept
+{
+  if (hasPendingInput)
+    return;
+
+  hasPendingInput = true;
+  pendingInputTime = std::chrono::steady_clock::now();
+}
+
+void ViewerApplication::frameBufferSizeCallback(
+    GLFWwindow* window,
+    int width,
+    int height)
+{
+  auto* app = static_cast<ViewerApplication*>(glfwGetWindowUserPointer(window));
+  app->viewportWidth = width;
+  app->viewportHeight = height;
+}
+
+void ViewerApplication::mouseCallback(
+    GLFWwindow* window,
+    double xpos,
+    double ypos)
+{
+  auto* app = static_cast<ViewerApplication*>(glfwGetWindowUserPointer(window));
+
+  if (app->firstMouse)
+  {
+    app->lastCursorX = xpos;
+    app->lastCursorY = ypos;
+    app->firstMouse = false;
+  }
+
+  double xoffset = xpos - app->lastCursorX, yoffset = app->lastCursorY - ypos;
+  app->lastCursorX = xpos, app->lastCursorY = ypos;
+
+  app->camera.updateDirection(
+      static_cast<float>(xoffset), static_cast<float>(yoffset));
+  app->markInput();
+}
+
+void ViewerApplication::scrollCallback(
+    GLFWwindow* window,
+    [[maybe_unused]] double xoffset,
+    double yoffset)
+{
+  auto* app = static_cast<ViewerApplication*>(glfwGetWindowUserPointer(window));
+  app->projection.updateFov(static_cast<float>(yoffset));
+  app->markInput();
+}
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "FrameStats.hpp"
+#include "HeadlessApplication.hpp"
+#include "Image.hpp"
+#include "Profiler.hpp"
+#include "stb/image.h"
+
+HeadlessOptions parseOptions(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+  using Clock = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  PROFILE_THREAD("Main");
+  HeadlessOptions options = parseOptions(argc, argv);
+  stbi_set_flip_vertically_on_load(true);
+
+  auto startupBegin = Clock::now();
+  HeadlessApplication app(options);
+  Milliseconds startup = Clock::now() - startupBegin;
+
+  app.run();
+
+  const FrameStats& stats = app.getFrameStats();
+  std::cout << std::fixed << std::setprecision(3)
+            << "startup_ms " << startup.count() << '\n'
+            << "frames " << stats.count() << '\n'
+            << "mean_ms " << stats.mean() << '\n'
+            << "p50_ms " << stats.percentile(0.50) << '\n'
+            << "p90_ms " << stats.percentile(0.90) << '\n'
+            << "p99_ms " << stats.percentile(0.99) << '\n'
+            << "max_ms " << stats.max() << '\n';
+
+  const FrameStats& triangles = app.getTriangleStats();
+  std::cout << "mean_triangles " << static_cast<long>(triangles.mean()) << '\n'
+            << "max_triangles " << static_cast<long>(triangles.max()) << '\n'
+            << "gpu_prepass_ms " << app.getPrepassGpuStats().mean() << '\n'
+            << "gpu_shading_ms " << app.getShadingGpuStats().mean() << '\n'
+            << "gpu_shadow_ms " << app.getShadowGpuStats().mean() << '\n'
+            << "gpu_lighting_ms " << app.getLightingGpuStats().mean() << '\n';
+
+  PROFILE_EXPORT("trace.json");
+
+  const auto& capture = app.getCapture();
+  if (capture && !options.capturePath.empty())
+    capture->writePng(options.capturePath, true);
+
+  if (capture && !options.comparePath.empty())
+  {
+    Image golden(options.comparePath);
+    double psnr = Image::psnr(*capture, golden);
+    bool passed = psnr >= options.minPsnr;
+
+    std::cout << "psnr_db " << psnr << '\n'
+              << "compare " << (passed ? "PASS" : "FAIL") << '\n';
+
+    if (!passed)
+      return 1;
+  }
+
+  return 0;
+}
+
+HeadlessOptions parseOptions(int argc, char** argv)
+{
+  HeadlessOptions options;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if (i + 1 >= argc)
+      throw std::runtime_error("Invalid Argument: Missing value for " + arg);
+
+    std::string value = argv[++i];
+    if (arg == "--width")
+      options.width = std::stoi(value);
+    else if (arg == "--height")
+      options.height = std::stoi(value);
+    else if (arg == "--frames")
+      options.frames = std::stoi(value);
+    else if (arg == "--warmup")
+      options.warmupFrames = std::stoi(value);
+    else if (arg == "--model")
+      options.modelPath = value;
+    else if (arg == "--gpu-culling")
+      options.gpuCulling = std::stoi(value) != 0;
+    else if (arg == "--depth-prepass")
+      options.depthPrepass = std::stoi(value) != 0;
+    else if (arg == "--position-stream")
+      options.positionStream = std::stoi(value) != 0;
+    else if (arg == "--shadows")
+      options.shadows = std::stoi(value) != 0;
+    else if (arg == "--deferred")
+      options.deferred = std::stoi(value) != 0;
+    else if (arg == "--lights")
+      options.lights = std::stoi(value);
+    else if (arg == "--reverse-z")
+      options.reverseZ = std::stoi(value) != 0;
+    else if (arg == "--occluders")
+      options.occluders = std::stoi(value) != 0;
+    else if (arg == "--capture-frame")
+      options.captureFrame = std::stoi(value);
+    else if (arg == "--capture")
+      options.capturePath = value;
+    else if (arg == "--compare")
+      options.comparePath = value;
+    else if (arg == "--min-psnr")
+      options.minPsnr = std::stod(value);
+    else
+      throw std::runtime_error("Invalid Argument: " + arg);
+  }
+  return options;
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "JobSystem.hpp"
+#include "OcclusionBuffer.hpp"
+
+// Occluders are given directly in clip space with an identity transform, so
+// NDC depth z lands in the buffer as z * 0.5 + 0.5.
+
+namespace
+{
+constexpr float EPSILON = 1e-3F;
+
+int failures = 0;
+
+void check(bool condition, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << "FAILED: " << what << '\n';
+    failures++;
+  }
+}
+
+// Quad from x0 to x1 across the full height, with NDC depth zLeft at x0 and
+// zRight at x1.
+void addQuad(
+    OcclusionBuffer& buffer,
+    float x0,
+    float x1,
+    float zLeft,
+    float zRight)
+{
+  std::vector<glm::vec3> positions = { { x0, -1.0F, zLeft },
+                                       { x1, -1.0F, zRight },
+                                       { x1, 1.0F, zRight },
+                                       { x0, 1.0F, zLeft } };
+  std::vector<unsigned int> indices = { 0, 1, 2, 0, 2, 3 };
+  buffer.addOccluder(positions, indices, indices.size(), glm::mat4(1.0F));
+}
+
+int levelSize(int size, std::size_t level)
+{
+  return ((size - 1) >> level) + 1;
+}
+
+bool pyramidIsConservative(const OcclusionBuffer& buffer)
+{
+  for (std::size_t level = 1; level < buffer.getLevelCount(); level++)
+  {
+    int sourceWidth = levelSize(buffer.getWidth(), level - 1);
+    int sourceHeight = levelSize(buffer.getHeight(), level - 1);
+    for (int y = 0; y < levelSize(buffer.getHeight(), level); y++)
+    {
+      for (int x = 0; x < levelSize(buffer.getWidth(), level); x++)
+      {
+        float farthest = 0.0F;
+        for (int sy = 2 * y; sy < std::min(2 * y + 2, sourceHeight); sy++)
+        {
+          for (int sx = 2 * x; sx < std::min(2 * x + 2, sourceWidth); sx++)
+            farthest = std::max(farthest, buffer.getDepth(sx, sy, level - 1));
+        }
+        if (buffer.getDepth(x, y, level) != farthest)
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+void testEmpty()
+{
+  OcclusionBuffer buffer;
+  buffer.finish();
+
+  check(buffer.getDepth(0, 0) == 1.0F, "empty buffer is at the far plane");
+  check(
+      buffer.isVisible({ glm::vec3(0.0F, 0.0F, 0.9F), 0.05F }, glm::mat4(1.0F)),
+      "nothing is occluded by an empty buffer");
+}
+
+void testHalfScreen(JobSystem* jobs)
+{
+  OcclusionBuffer buffer(
+      OcclusionBuffer::DEFAULT_WIDTH, OcclusionBuffer::DEFAULT_HEIGHT, jobs);
+  addQuad(buffer, -1.0F, 0.0F, 0.0F, 0.0F);
+  buffer.finish();
+
+  int width = buffer.getWidth();
+  int height = buffer.getHeight();
+  check(buffer.getTriangleCount() == 2, "both triangles are binned");
+  check(
+      std::abs(buffer.getDepth(0, 0) - 0.5F) < EPSILON,
+      "covered corner holds the occluder depth");
+  check(
+      std::abs(buffer.getDepth(width / 2 - 1, height - 1) - 0.5F) < EPSILON,
+      "last covered column holds the occluder depth");
+  check(
+      buffer.getDepth(width / 2, height / 2) == 1.0F,
+      "uncovered half stays at the far plane");
+
+  std::size_t top = buffer.getLevelCount() - 1;
+  check(top == 8, "pyramid reduces 256x128 to a single texel");
+  check(
+      std::abs(buffer.getDepth(0, 0, top - 1) - 0.5F) < EPSILON,
+      "covered half reduces to the occluder depth");
+  check(
+      buffer.getDepth(1, 0, top - 1) == 1.0F,
+      "uncovered half reduces to the far plane");
+  check(buffer.getDepth(0, 0, top) == 1.0F, "top level keeps the farthest");
+  check(pyramidIsConservative(buffer), "each texel is the max of its four");
+
+  glm::mat4 identity(1.0F);
+  check(
+      !buffer.isVisible({ glm::vec3(-0.5F, 0.0F, 0.5F), 0.1F }, identity),
+      "sphere behind the occluder is hidden");
+  check(
+      buffer.isVisible({ glm::vec3(-0.5F, 0.0F, -0.5F), 0.1F }, identity),
+      "sphere in front of the occluder is visible");
+  check(
+      buffer.isVisible({ glm::vec3(0.5F, 0.0F, 0.5F), 0.1F }, identity),
+      "sphere beside the occluder is visible");
+  check(
+      buffer.isVisible({ glm::vec3(0.0F, 0.0F, 0.5F), 0.1F }, identity),
+      "sphere straddling the occluder edge is visible");
+  check(
+      !buffer.isVisible({ glm::vec3(-0.5F, 0.0F, 0.5F), 0.45F }, identity),
+      "large sphere behind the occluder is hidden at a coarser level");
+}
+
+void testSlope()
+{
+  OcclusionBuffer buffer;
+  addQuad(buffer, -1.0F, 1.0F, -1.0F, 1.0F);
+  buffer.finish();
+
+  int width = buffer.getWidth();
+  bool interpolated = true;
+  for (int x = 0; x < width; x++)
+  {
+    float expected = (static_cast<float>(x) + 0.5F) / static_cast<float>(width);
+    interpolated = interpolated && std::abs(buffer.getDepth(x, 7) - expected) <
+                                       EPSILON;
+  }
+  check(interpolated, "depth is interpolated across the occluder");
+  check(pyramidIsConservative(buffer), "sloped pyramid keeps the farthest");
+
+  buffer.clear();
+  buffer.finish();
+  check(buffer.getDepth(0, 0) == 1.0F, "clear resets to the far plane");
+}
+}  // namespace
+
+int main()
+{
+  JobSystem jobs(3);
+
+  testEmpty();
+  testHalfScreen(nullptr);
+  testHalfScreen(&jobs);
+  testSlope();
+
+  if (failures > 0)
+  {
+    std::cerr << failures << " check(s) failed\n";
+    return 1;
+  }
+  std::cout << "all checks passed\n";
+  return 0;
+}